@@ -690,7 +690,14 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
-	optimiseInternal(_settings, {});
+	if (_settings.runConstantOptimiser && !_settings.constantRepresentationCache)
+	{
+		OptimiserSettings settings = _settings;
+		settings.constantRepresentationCache = std::make_shared<ConstantRepresentationCache>();
+		optimiseInternal(settings, {});
+	}
+	else
+		optimiseInternal(_settings, {});
 	return *this;
 }
 
@@ -778,44 +785,59 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// The cross-block mode below only propagates knowledge to tags whose predecessors are
+			// all statically known, which takes care of this.
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
+			if (_settings.runCSEAcrossBlocks)
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
-				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
-				}
-
-				if (shouldReplace)
+				unsigned replacedChunks = 0;
+				std::tie(optimisedItems, replacedChunks) = CommonSubexpressionEliminator::optimiseAcrossBlocks(
+					m_items,
+					usesMSize,
+					_tagsReferencedFromOutside
+				);
+				count += replacedChunks;
+			}
+			else
+			{
+				auto iter = m_items.begin();
+				while (iter != m_items.end())
 				{
-					count++;
-					optimisedItems += optimisedChunk;
+					KnownState emptyState;
+					CommonSubexpressionEliminator eliminator{emptyState};
+					auto orig = iter;
+					iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+					bool shouldReplace = false;
+					AssemblyItems optimisedChunk;
+					try
+					{
+						optimisedChunk = eliminator.getOptimizedItems();
+						shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
+					}
+					catch (StackTooDeepException const&)
+					{
+						// This might happen if the opcode reconstruction is not as efficient
+						// as the hand-crafted code.
+					}
+					catch (ItemNotAvailableException const&)
+					{
+						// This might happen if e.g. associativity and commutativity rules
+						// reorganise the expression tree, but not all leaves are available.
+					}
+
+					if (shouldReplace)
+					{
+						count++;
+						optimisedItems += optimisedChunk;
+					}
+					else
+						copy(orig, iter, back_inserter(optimisedItems));
 				}
-				else
-					copy(orig, iter, back_inserter(optimisedItems));
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -830,7 +852,8 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			isCreation(),
 			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.constantRepresentationCache.get()
 		);
 
 	m_tagReplacements = std::move(tagReplacements);
@@ -1182,12 +1205,13 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, false, _evmVersion, 0, nullptr};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runCSEAcrossBlocks = _settings.runCSEAcrossBlocks;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = _evmVersion;
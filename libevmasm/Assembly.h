@@ -21,6 +21,7 @@
 #include <libevmasm/Instruction.h>
 #include <liblangutil/SourceLocation.h>
 #include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/LinkerObject.h>
 #include <libevmasm/Exceptions.h>
 
@@ -124,11 +125,16 @@ public:
 		bool runPeephole = false;
 		bool runDeduplicate = false;
 		bool runCSE = false;
+		/// Propagate knowledge of the CSE across basic blocks where all predecessors are known.
+		bool runCSEAcrossBlocks = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Representations of constants found by the constant optimiser. If not set, each call to
+		/// optimise() uses a cache shared by the assembly and all of its sub-assemblies.
+		std::shared_ptr<ConstantRepresentationCache> constantRepresentationCache;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
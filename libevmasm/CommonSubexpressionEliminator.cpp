@@ -26,9 +26,11 @@
 #include <libsolutil/Keccak256.h>
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ControlFlowGraph.h>
 #include <libsolutil/StackTooDeepString.h>
 
 #include <range/v3/view/reverse.hpp>
+#include <optional>
 #include <utility>
 
 using namespace solidity;
@@ -74,6 +76,160 @@ std::vector<AssemblyItem> CommonSubexpressionEliminator::getOptimizedItems()
 	return items;
 }
 
+std::pair<AssemblyItems, unsigned> CommonSubexpressionEliminator::optimiseAcrossBlocks(
+	AssemblyItems const& _items,
+	bool _msizeImportant,
+	std::set<size_t> const& _tagsReferencedFromOutside
+)
+{
+	// Knowledge about the state together with the point it originates from. Knowledge is only
+	// combined at join points if all of it has the same origin, i.e. if all paths from the origin
+	// to the join point only pass through items that are fully modelled by KnownState. Otherwise,
+	// expressions like TLOAD that are not sequenced could end up in the same class although
+	// they were evaluated before and after a modification.
+	struct Knowledge
+	{
+		KnownState state;
+		size_t origin;
+		bool inherited;
+	};
+
+	auto expressionClasses = std::make_shared<ExpressionClasses>();
+	size_t nextOrigin = 0;
+	// Sequence numbers are never reused by different chunks, so that sequenced expressions
+	// (loads and hashes) evaluated on different paths never end up in the same class.
+	unsigned nextSequenceNumber = 1;
+	auto noKnowledge = [&]() { return Knowledge{KnownState{expressionClasses}, nextOrigin++, false}; };
+
+	std::map<size_t, std::vector<size_t>> jumpSources = ControlFlowGraph::staticJumpSources(_items, _tagsReferencedFromOutside);
+	std::map<size_t, Knowledge> knowledgeAtJump;
+	// Knowledge at the current position. Empty if the position cannot be reached by falling
+	// through from the previous item.
+	std::optional<Knowledge> knowledge = noKnowledge();
+
+	auto knowledgeAfterTag = [&](AssemblyItem const& _tag) -> Knowledge
+	{
+		auto sources = jumpSources.find(static_cast<size_t>(_tag.data()));
+		if (sources == jumpSources.end())
+			return noKnowledge();
+		std::vector<Knowledge const*> predecessors;
+		if (knowledge)
+			predecessors.emplace_back(&*knowledge);
+		for (size_t jump: sources->second)
+		{
+			auto it = knowledgeAtJump.find(jump);
+			// Jumps we have not seen yet are backwards jumps.
+			if (it == knowledgeAtJump.end())
+				return noKnowledge();
+			predecessors.emplace_back(&it->second);
+		}
+		if (predecessors.empty())
+			return noKnowledge();
+		Knowledge joined = *predecessors.front();
+		for (Knowledge const* predecessor: predecessors)
+			if (predecessor->origin != joined.origin)
+				return noKnowledge();
+			else if (predecessor != predecessors.front())
+				joined.state.reduceToCommonKnowledge(predecessor->state, true);
+		joined.state.clearTagUnions();
+		joined.inherited = true;
+		return joined;
+	};
+
+	auto optimisedChunk = [](CommonSubexpressionEliminator& _eliminator, size_t _originalSize) -> std::optional<AssemblyItems>
+	{
+		try
+		{
+			AssemblyItems chunk = _eliminator.getOptimizedItems();
+			if (chunk.size() < _originalSize)
+				return chunk;
+		}
+		catch (StackTooDeepException const&)
+		{
+			// This might happen if the opcode reconstruction is not as efficient
+			// as the hand-crafted code or if a value known from a previous chunk
+			// is not available on the stack anymore.
+		}
+		catch (ItemNotAvailableException const&)
+		{
+			// This might happen if e.g. associativity and commutativity rules
+			// reorganise the expression tree, but not all leaves are available.
+		}
+		return std::nullopt;
+	};
+
+	AssemblyItems optimisedItems;
+	unsigned replacedChunks = 0;
+	auto iter = _items.begin();
+	while (iter != _items.end())
+	{
+		if (iter->type() == Tag)
+		{
+			knowledge = knowledgeAfterTag(*iter);
+			optimisedItems.push_back(*iter++);
+			continue;
+		}
+		if (!knowledge)
+			knowledge = noKnowledge();
+		knowledge->state.advanceSequenceNumber(nextSequenceNumber);
+
+		auto orig = iter;
+		CommonSubexpressionEliminator eliminator{knowledge->state};
+		iter = eliminator.feedItems(iter, _items.end(), _msizeImportant);
+		size_t originalSize = static_cast<size_t>(iter - orig);
+		AssemblyItem const* breakingItem =
+			(iter != orig && SemanticInformation::breaksCSEAnalysisBlock(*std::prev(iter), _msizeImportant)) ?
+			&*std::prev(iter) :
+			nullptr;
+
+		std::optional<AssemblyItems> chunk = optimisedChunk(eliminator, originalSize);
+		if (!chunk && knowledge->inherited)
+		{
+			// Retry without the inherited knowledge, which is what we would have done anyway.
+			KnownState emptyState;
+			CommonSubexpressionEliminator freshEliminator{emptyState};
+			freshEliminator.feedItems(orig, iter, _msizeImportant);
+			chunk = optimisedChunk(freshEliminator, originalSize);
+		}
+		if (chunk)
+		{
+			++replacedChunks;
+			optimisedItems += *chunk;
+		}
+		else
+			copy(orig, iter, back_inserter(optimisedItems));
+
+		// The knowledge of the eliminator is valid regardless of which version of the chunk we use.
+		Knowledge next{eliminator.state(), knowledge->origin, true};
+		nextSequenceNumber = std::max(nextSequenceNumber, next.state.sequenceNumber() + 1);
+		if (!breakingItem)
+			knowledge = std::move(next);
+		else if (breakingItem->type() == Tag)
+		{
+			knowledge = std::move(next);
+			knowledge = knowledgeAfterTag(*breakingItem);
+		}
+		else if (*breakingItem == Instruction::JUMP || *breakingItem == Instruction::JUMPI)
+		{
+			knowledgeAtJump.emplace(static_cast<size_t>(std::prev(iter) - _items.begin()), next);
+			if (*breakingItem == Instruction::JUMPI)
+				knowledge = std::move(next);
+			else
+				knowledge.reset();
+		}
+		else if (
+			breakingItem->type() == Operation &&
+			SemanticInformation::terminatesControlFlow(breakingItem->instruction())
+		)
+			knowledge.reset();
+		else
+			// The effects of all other items that break a block are not (fully) modelled.
+			knowledge = noKnowledge();
+	}
+
+	return {std::move(optimisedItems), replacedChunks};
+}
+
 void CommonSubexpressionEliminator::feedItem(AssemblyItem const& _item, bool _copyItem)
 {
 	StoreOperation op = m_state.feedItem(_item, _copyItem);
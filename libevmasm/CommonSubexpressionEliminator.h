@@ -29,6 +29,7 @@
 #include <set>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
@@ -77,6 +78,22 @@ public:
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
+	/// @returns the knowledge about the state after the items fed so far. After a call to
+	/// getOptimizedItems, this includes the effects of the item that broke the block.
+	KnownState const& state() const { return m_state; }
+
+	/// Runs the eliminator on all chunks of @a _items. In contrast to optimising each chunk
+	/// starting from an empty state, the knowledge gathered at the end of a chunk is propagated
+	/// into the chunks that follow it in control flow, as long as all predecessors of a chunk are
+	/// statically known (see ControlFlowGraph::staticJumpSources) and processed before it.
+	/// @param _msizeImportant if false, do not consider modification of MSIZE a side-effect
+	/// @returns the optimised items and the number of chunks that were replaced.
+	static std::pair<AssemblyItems, unsigned> optimiseAcrossBlocks(
+		AssemblyItems const& _items,
+		bool _msizeImportant,
+		std::set<size_t> const& _tagsReferencedFromOutside
+	);
+
 private:
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
@@ -31,7 +31,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	ConstantRepresentationCache* _cache
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -43,6 +44,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		if (item.type() == Push)
 			pushes[item]++;
 	std::map<u256, AssemblyItems> pendingReplacements;
+	ConstantRepresentationCache localCache;
+	ConstantRepresentationCache& cache = _cache ? *_cache : localCache;
 	for (auto it: pushes)
 	{
 		AssemblyItem const& item = it.first;
@@ -57,7 +60,7 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		bigint literalGas = lit.gasNeeded();
 		CodeCopyMethod copy(params, item.data());
 		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
+		ComputeMethod compute(params, item.data(), &cache);
 		bigint computeGas = compute.gasNeeded();
 		AssemblyItems replacement;
 		if (copyGas < literalGas && copyGas < computeGas)
@@ -187,6 +190,35 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 }
 
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
+{
+	if (!m_cache)
+		return searchRepresentation(_value);
+
+	auto key = std::make_tuple(_value, m_params.evmVersion, m_params.isCreation, m_params.runs, m_params.multiplicity);
+	// A cached search that used fewer steps than we have left would have ended the same way
+	// if it had been performed now.
+	if (auto it = m_cache->entries.find(key); it != m_cache->entries.end() && it->second.steps < m_maxSteps)
+	{
+		m_maxSteps -= it->second.steps;
+		++m_cache->hits;
+		return it->second.routine;
+	}
+
+	size_t stepsBefore = m_maxSteps;
+	AssemblyItems routine = searchRepresentation(_value);
+	// Only store complete searches, which do not depend on the budget and thus not on the order
+	// in which constants are optimised.
+	if (m_maxSteps > 0)
+	{
+		// The cache is never required for correctness, keep its size in check.
+		if (m_cache->entries.size() >= 0x10000)
+			m_cache->entries.clear();
+		m_cache->entries[key] = ConstantRepresentationCache::Entry{routine, stepsBefore - m_maxSteps};
+	}
+	return routine;
+}
+
+AssemblyItems ComputeMethod::searchRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
 		// Very small value, not worth computing
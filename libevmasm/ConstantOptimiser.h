@@ -29,6 +29,8 @@
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
 
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace solidity::evmasm
@@ -38,6 +40,26 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
 
+/**
+ * Representations of constants found by complete searches of the ComputeMethod, keyed by the
+ * value and all parameters the search depends on. Constants like masks and selectors tend to
+ * repeat within an assembly and across its sub-assemblies.
+ * Not thread-safe, a cache can only be used by one optimiser run at a time.
+ */
+struct ConstantRepresentationCache
+{
+	struct Entry
+	{
+		AssemblyItems routine;
+		/// Number of steps the search consumed, used to reproduce the outcome of a search
+		/// that runs with a smaller remaining budget.
+		size_t steps;
+	};
+	std::map<std::tuple<u256, langutil::EVMVersion, bool, size_t, size_t>, Entry> entries;
+	/// Number of searches answered from the cache.
+	size_t hits = 0;
+};
+
 /**
  * Abstract base class for one way to change how constants are represented in the code.
  */
@@ -45,13 +67,14 @@ class ConstantOptimisationMethod
 {
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
-	/// @a _assembly.
+	/// @a _assembly. Representations are looked up in and added to @a _cache, if given.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		ConstantRepresentationCache* _cache = nullptr
 	);
 
 protected:
@@ -132,8 +155,10 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
+	/// @param _cache if non-null, used to look up and store representations of subvalues.
+	explicit ComputeMethod(Params const& _params, u256 const& _value, ConstantRepresentationCache* _cache = nullptr):
+		ConstantOptimisationMethod(_params, _value),
+		m_cache(_cache)
 	{
 		m_routine = findRepresentation(m_value);
 		assertThrow(
@@ -151,14 +176,18 @@ public:
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
+	/// Results are taken from and stored in the cache of representations.
 	AssemblyItems findRepresentation(u256 const& _value);
+	/// Searches for a way to compute @a _value, bypassing the cache for @a _value itself.
+	AssemblyItems searchRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
 	bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const;
 	bigint gasNeeded(AssemblyItems const& _routine) const;
 
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
-	size_t m_maxSteps = 10000;
+	size_t m_maxSteps = 50000;
 	AssemblyItems m_routine;
+	ConstantRepresentationCache* m_cache = nullptr;
 };
 
 }
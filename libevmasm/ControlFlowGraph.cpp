@@ -55,6 +55,40 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+std::map<size_t, std::vector<size_t>> ControlFlowGraph::staticJumpSources(
+	AssemblyItems const& _items,
+	std::set<size_t> const& _tagsReferencedFromOutside
+)
+{
+	std::map<size_t, std::vector<size_t>> jumpSources;
+	std::set<size_t> dynamicTargets = _tagsReferencedFromOutside;
+	for (size_t index = 0; index < _items.size(); ++index)
+	{
+		AssemblyItem const& item = _items[index];
+		if (item.type() == VerbatimBytecode)
+			// We cannot say anything about jumps inside verbatim code.
+			return {};
+		else if (item.type() == Tag)
+			jumpSources[static_cast<size_t>(item.data())];
+		else if (item.type() == PushTag)
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			if (subId != std::numeric_limits<size_t>::max())
+				continue;
+			if (
+				index + 1 < _items.size() &&
+				(_items[index + 1] == Instruction::JUMP || _items[index + 1] == Instruction::JUMPI)
+			)
+				jumpSources[tag].push_back(index + 1);
+			else
+				dynamicTargets.insert(tag);
+		}
+	}
+	for (size_t tag: dynamicTargets)
+		jumpSources.erase(tag);
+	return jumpSources;
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
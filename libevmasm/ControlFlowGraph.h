@@ -29,8 +29,10 @@
 #include <libevmasm/ExpressionClasses.h>
 
 #include <vector>
+#include <map>
 #include <memory>
 #include <limits>
+#include <set>
 
 namespace solidity::evmasm
 {
@@ -109,6 +111,17 @@ public:
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
 
+	/// @returns, for each tag in @a _items whose predecessors are all statically known, the
+	/// positions of the jumps that target it.
+	/// This is the case if the tag is not referenced from outside the assembly and every push of
+	/// it is immediately consumed by a JUMP or JUMPI. Any other tag might be the target of a
+	/// dynamic jump (its value can be a return address or an internal function pointer stored in
+	/// memory or storage) and is not contained in the result.
+	static std::map<size_t, std::vector<size_t>> staticJumpSources(
+		AssemblyItems const& _items,
+		std::set<size_t> const& _tagsReferencedFromOutside
+	);
+
 private:
 	void findLargestTag();
 	void splitBlocks();
@@ -50,6 +50,7 @@
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -119,6 +120,10 @@ public:
 	void reset() { resetStorage(); resetMemory(); resetKnownKeccak256Hashes(); resetStack(); }
 
 	unsigned sequenceNumber() const { return m_sequenceNumber; }
+	/// Raises the sequence number to at least @a _sequenceNumber, so that sequenced expressions
+	/// created from now on are distinct from those created by other states sharing the
+	/// expression classes.
+	void advanceSequenceNumber(unsigned _sequenceNumber) { m_sequenceNumber = std::max(m_sequenceNumber, _sequenceNumber); }
 
 	/// Replaces the state by the intersection with _other, i.e. only equal knowledge is retained.
 	/// If the stack heighht is different, the smaller one is used and the stack is compared
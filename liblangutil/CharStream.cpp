@@ -51,6 +51,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace solidity;
 using namespace solidity::langutil;
 
@@ -101,19 +104,28 @@ std::string CharStream::lineAtPosition(int _position) const
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = std::string::size_type;
-	using diff_type = std::string::difference_type;
-	size_type searchPosition = std::min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t searchPosition = std::min<size_t>(m_source.size(), static_cast<size_t>(_position));
+	std::vector<size_t> const& starts = m_lineStarts;
+	// The first entry is zero, so the line containing the position is always found.
+	auto line = std::prev(std::upper_bound(starts.begin(), starts.end(), searchPosition));
+	return LineColumn{
+		static_cast<int>(line - starts.begin()),
+		static_cast<int>(searchPosition - *line)
+	};
+}
+
+void CharStream::computeLineStarts()
+{
+	m_lineStarts = {0};
+	char const* begin = m_source.data();
+	char const* end = begin + m_source.size();
+	// memchr is vectorized by the C library, which makes this much faster than a plain loop.
+	for (
+		char const* lineFeed = static_cast<char const*>(std::memchr(begin, '\n', m_source.size()));
+		lineFeed;
+		lineFeed = static_cast<char const*>(std::memchr(lineFeed + 1, '\n', static_cast<size_t>(end - lineFeed - 1)))
+	)
+		m_lineStarts.push_back(static_cast<size_t>(lineFeed - begin) + 1);
 }
 
 std::string_view CharStream::text(SourceLocation const& _location) const
@@ -146,7 +158,16 @@ std::string CharStream::singleLineSnippet(std::string const& _sourceCode, Source
 
 std::optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	std::vector<size_t> const& starts = m_lineStarts;
+	if (_lineColumn.line < 0 || _lineColumn.column < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size())
+		return std::nullopt;
+
+	size_t line = static_cast<size_t>(_lineColumn.line);
+	size_t offset = starts[line];
+	size_t endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (offset + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return std::nullopt;
+	return static_cast<int>(offset + static_cast<size_t>(_lineColumn.column));
 }
 
 std::optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -55,6 +55,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -72,12 +73,17 @@ class CharStream
 public:
 	CharStream() = default;
 	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
+		m_source(std::move(_source)), m_name(std::move(_name))
+	{
+		computeLineStarts();
+	}
 	CharStream(std::string _source, std::string _name, bool _importedFromAST):
 		m_source(std::move(_source)),
 		m_name(std::move(_name)),
 		m_importedFromAST(_importedFromAST)
-	{ }
+	{
+		computeLineStarts();
+	}
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
@@ -109,6 +115,7 @@ public:
 	///@}
 
 	/// Translates a line:column to the absolute position.
+	/// Uses the line index of this stream, so unlike the static variant it does not scan the source.
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
@@ -142,10 +149,17 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// Fills @a m_lineStarts. The index is built on construction rather than on first use,
+	/// so that streams can be queried from several threads, as the language server does.
+	void computeLineStarts();
+
 	std::string m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
+	/// The positions at which the lines of the source start, i.e. zero and every
+	/// position following a line feed.
+	std::vector<size_t> m_lineStarts{0};
 };
 
 }
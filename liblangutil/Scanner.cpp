@@ -61,6 +61,10 @@
 #include <tuple>
 #include <array>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 namespace solidity::langutil
 {
@@ -96,6 +100,171 @@ std::ostream& operator<<(std::ostream& os, ScannerError _errorCode)
 	return os << to_string(_errorCode);
 }
 
+namespace
+{
+
+/// Classes of characters that the scanner skips over in bulk. Each class provides a scalar
+/// membership test and, if SSE2 is available, the same test for 16 characters at a time.
+/// All classes exclude '\0', which is what the scanner sees at the end of the input.
+#if defined(__SSE2__)
+__m128i equalTo(__m128i _block, char _c)
+{
+	return _mm_cmpeq_epi8(_block, _mm_set1_epi8(_c));
+}
+
+/// Unsigned comparison _low <= c <= _high for every byte c of the block.
+__m128i inRange(__m128i _block, uint8_t _low, uint8_t _high)
+{
+	__m128i const shifted = _mm_sub_epi8(_block, _mm_set1_epi8(static_cast<char>(_low)));
+	return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(_high - _low))), shifted);
+}
+
+__m128i negate(__m128i _block)
+{
+	return _mm_xor_si128(_block, _mm_set1_epi8(-1));
+}
+#endif
+
+/// Characters that may end a line, including the first byte of the UTF-8 encodings of
+/// NEL, LS and PS (see Scanner::isUnicodeLinebreak).
+bool isLinebreakStart(char _c)
+{
+	return (0x0a <= _c && _c <= 0x0d) || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+struct WhiteSpace
+{
+	static bool matches(char _c) { return isWhiteSpace(_c); }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(equalTo(_block, ' '), equalTo(_block, '\t')),
+			_mm_or_si128(equalTo(_block, '\n'), equalTo(_block, '\r'))
+		);
+	}
+#endif
+};
+
+struct SpaceOrTab
+{
+	static bool matches(char _c) { return _c == ' ' || _c == '\t'; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block) { return _mm_or_si128(equalTo(_block, ' '), equalTo(_block, '\t')); }
+#endif
+};
+
+/// Characters of a single-line comment that cannot end it.
+struct SingleLineCommentText
+{
+	static bool matches(char _c) { return _c != 0 && !isLinebreakStart(_c); }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block)
+	{
+		return negate(_mm_or_si128(
+			_mm_or_si128(equalTo(_block, 0), inRange(_block, 0x0a, 0x0d)),
+			_mm_or_si128(equalTo(_block, '\xc2'), equalTo(_block, '\xe2'))
+		));
+	}
+#endif
+};
+
+/// Characters of a multi-line comment that cannot end it and are not treated specially
+/// in documentation comments.
+struct MultiLineCommentText
+{
+	static bool matches(char _c) { return _c != 0 && _c != '*' && _c != '\n' && _c != '\r'; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block)
+	{
+		return negate(_mm_or_si128(
+			_mm_or_si128(equalTo(_block, 0), equalTo(_block, '*')),
+			_mm_or_si128(equalTo(_block, '\n'), equalTo(_block, '\r'))
+		));
+	}
+#endif
+};
+
+/// Characters that cannot start a Unicode directional formatting character.
+struct NonDirectionalFormatting
+{
+	static bool matches(char _c) { return uint8_t(_c) != 0xe2; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block) { return negate(equalTo(_block, '\xe2')); }
+#endif
+};
+
+template<bool _withDot>
+struct IdentifierPart
+{
+	static bool matches(char _c) { return isIdentifierPart(_c) || (_withDot && _c == '.'); }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block)
+	{
+		__m128i result = _mm_or_si128(
+			// Setting bit 5 maps upper case to lower case letters and nothing else into a-z.
+			inRange(_mm_or_si128(_block, _mm_set1_epi8(0x20)), 'a', 'z'),
+			inRange(_block, '0', '9')
+		);
+		result = _mm_or_si128(result, _mm_or_si128(equalTo(_block, '_'), equalTo(_block, '$')));
+		if constexpr (_withDot)
+			result = _mm_or_si128(result, equalTo(_block, '.'));
+		return result;
+	}
+#endif
+};
+
+/// Characters of a string literal that are copied to the literal unchanged: printable ASCII
+/// characters other than quotes and backslash and, for Unicode literals, all other characters
+/// that cannot start a line break.
+template<bool _isUnicode>
+struct PlainStringCharacter
+{
+	static bool matches(char _c)
+	{
+		if (_c == '"' || _c == '\'' || _c == '\\')
+			return false;
+		if constexpr (_isUnicode)
+			return _c != 0 && !isLinebreakStart(_c);
+		else
+			return 0x20 <= _c && _c <= 0x7e;
+	}
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _block)
+	{
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(equalTo(_block, '"'), equalTo(_block, '\'')),
+			equalTo(_block, '\\')
+		);
+		if constexpr (_isUnicode)
+			return _mm_andnot_si128(special, SingleLineCommentText::matches(_block));
+		else
+			return _mm_andnot_si128(special, inRange(_block, 0x20, 0x7e));
+	}
+#endif
+};
+
+/// @returns the position of the first character at or after @a _position in @a _text
+/// that is not in @a CharacterClass, or the size of the text if there is none.
+template<typename CharacterClass>
+size_t skipCharacterClass(std::string_view _text, size_t _position)
+{
+#if defined(__SSE2__)
+	for (; _position + 16 <= _text.size(); _position += 16)
+	{
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + _position));
+		unsigned const outside = static_cast<unsigned>(_mm_movemask_epi8(CharacterClass::matches(block))) ^ 0xffffu;
+		if (outside)
+			return _position + static_cast<size_t>(__builtin_ctz(outside));
+	}
+#endif
+	while (_position < _text.size() && CharacterClass::matches(_text[_position]))
+		++_position;
+	return _position;
+}
+
+}
+
 /// Scoped helper for literal recording. Automatically drops the literal
 /// if aborting the scanning before it's complete.
 enum LiteralType
@@ -248,8 +417,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	// m_char is not necessarily the character at the current position (see skipMultiLineComment),
+	// so it is consumed individually before skipping in bulk.
+	if (isWhiteSpace(m_char))
+	{
 		advance();
+		m_char = m_source.setPosition(skipCharacterClass<WhiteSpace>(m_source.source(), sourcePos()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -257,8 +431,12 @@ bool Scanner::skipWhitespace()
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+	// Within whitespace, only '\n' and '\r' are line breaks.
+	if (SpaceOrTab::matches(m_char))
+	{
 		advance();
+		m_char = m_source.setPosition(skipCharacterClass<SpaceOrTab>(m_source.source(), sourcePos()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -286,8 +464,13 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	_stream.setPosition(_startPosition);
 
 	int directionOverrideDepth = 0;
+	std::string_view const source = std::string_view{_stream.source()}.substr(0, endPosition);
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	for (
+		size_t currentPos = skipCharacterClass<NonDirectionalFormatting>(source, _startPosition);
+		currentPos < endPosition;
+		currentPos = skipCharacterClass<NonDirectionalFormatting>(source, currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -312,8 +495,11 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
 	while (!isUnicodeLinebreak())
+	{
 		if (!advance())
 			break;
+		m_char = m_source.setPosition(skipCharacterClass<SingleLineCommentText>(m_source.source(), sourcePos()));
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -383,6 +569,9 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		size_t const textEnd = skipCharacterClass<SingleLineCommentText>(m_source.source(), sourcePos());
+		m_skippedComments[NextNext].literal.append(m_source.source(), sourcePos(), textEnd - sourcePos());
+		m_char = m_source.setPosition(textEnd);
 	}
 	literal.complete();
 	return endPosition;
@@ -408,6 +597,8 @@ Token Scanner::skipMultiLineComment()
 			m_char = ' ';
 			return Token::Whitespace;
 		}
+		// Only a '*' can start the terminator.
+		m_char = m_source.setPosition(skipCharacterClass<MultiLineCommentText>(m_source.source(), sourcePos()));
 	}
 	// Unterminated multi-line comment.
 	return setError(ScannerError::IllegalCommentTerminator);
@@ -460,6 +651,9 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		size_t const textEnd = skipCharacterClass<MultiLineCommentText>(m_source.source(), sourcePos());
+		m_skippedComments[NextNext].literal.append(m_source.source(), sourcePos(), textEnd - sourcePos());
+		m_char = m_source.setPosition(textEnd);
 	}
 	literal.complete();
 	if (!endFound)
@@ -850,6 +1044,11 @@ Token Scanner::scanString(bool const _isUnicode)
 				return setError(ScannerError::UnicodeCharacterInNonUnicodeString);
 			}
 			addLiteralChar(c);
+			size_t const plainEnd = _isUnicode ?
+				skipCharacterClass<PlainStringCharacter<true>>(m_source.source(), sourcePos()) :
+				skipCharacterClass<PlainStringCharacter<false>>(m_source.source(), sourcePos());
+			m_tokens[NextNext].literal.append(m_source.source(), sourcePos(), plainEnd - sourcePos());
+			m_char = m_source.setPosition(plainEnd);
 		}
 	}
 	if (m_char != quote)
@@ -1016,8 +1215,11 @@ std::tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	size_t const identifierEnd = m_kind == ScannerKind::Yul ?
+		skipCharacterClass<IdentifierPart<true>>(m_source.source(), sourcePos()) :
+		skipCharacterClass<IdentifierPart<false>>(m_source.source(), sourcePos());
+	m_tokens[NextNext].literal.append(m_source.source(), sourcePos(), identifierEnd - sourcePos());
+	m_char = m_source.setPosition(identifierEnd);
 	literal.complete();
 
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
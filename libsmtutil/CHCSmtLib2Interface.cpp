@@ -18,6 +18,8 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -184,11 +186,25 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 		return m_queryResponses.at(inputHash);
 
 	smtAssert(m_enabledSolvers.smtlib2 || m_enabledSolvers.eld);
+	// The timeout is part of the query.
+	std::string const solver = m_enabledSolvers.eld ? "eld" : "smtlib2";
+	if (m_queryCache)
+		// Only answers are stored, anything else is treated as missing.
+		if (
+			auto response = m_queryCache->lookup(solver, _input);
+			response && (boost::starts_with(*response, "sat") || boost::starts_with(*response, "unsat"))
+		)
+			return *response;
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+		{
+			auto const& response = result.responseOrErrorMessage;
+			if (m_queryCache && (boost::starts_with(response, "sat") || boost::starts_with(response, "unsat")))
+				m_queryCache->store(solver, _input, response);
+			return response;
+		}
 	}
 
 	m_unhandledQueries.push_back(_input);
@@ -25,6 +25,7 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -59,8 +60,12 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets the persistent cache of answers to queries.
+	void setQueryCache(std::shared_ptr<QueryCache> _queryCache) { m_queryCache = std::move(_queryCache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache> m_queryCache;
 };
 
 }
@@ -0,0 +1,268 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+
+#include <fstream>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+std::map<CheckResult, std::string> const checkResultNames{
+	{CheckResult::SATISFIABLE, "sat"},
+	{CheckResult::UNSATISFIABLE, "unsat"},
+	{CheckResult::UNKNOWN, "unknown"},
+	{CheckResult::CONFLICTING, "conflicting"},
+	{CheckResult::ERROR, "error"}
+};
+
+}
+
+QueryCache::QueryCache(boost::filesystem::path _directory):
+	m_directory(std::move(_directory))
+{
+	boost::system::error_code error;
+	boost::filesystem::create_directories(m_directory, error);
+}
+
+std::optional<std::string> QueryCache::lookup(std::string const& _solver, std::string const& _query) const
+{
+	auto path = entryPath(_solver, _query);
+	boost::system::error_code error;
+	if (!boost::filesystem::is_regular_file(path, error))
+		return std::nullopt;
+	try
+	{
+		return readFileAsString(path);
+	}
+	catch (FileNotFound const&)
+	{
+		return std::nullopt;
+	}
+	catch (NotAFile const&)
+	{
+		return std::nullopt;
+	}
+}
+
+std::optional<Json::Value> QueryCache::lookupJson(std::string const& _solver, std::string const& _query) const
+{
+	auto answer = lookup(_solver, _query);
+	if (!answer)
+		return std::nullopt;
+	Json::Value json;
+	if (!jsonParseStrict(*answer, json))
+		return std::nullopt;
+	return json;
+}
+
+void QueryCache::store(std::string const& _solver, std::string const& _query, std::string const& _answer) const
+{
+	auto path = entryPath(_solver, _query);
+	// Write to a temporary file first, so that readers never see a partially written answer.
+	auto temporaryPath = path;
+	temporaryPath += boost::filesystem::unique_path(".%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		file << _answer;
+		if (!file)
+			return;
+	}
+	boost::system::error_code error;
+	boost::filesystem::rename(temporaryPath, path, error);
+	if (error)
+		boost::filesystem::remove(temporaryPath, error);
+}
+
+void QueryCache::store(std::string const& _solver, std::string const& _query, Json::Value const& _answer) const
+{
+	store(_solver, _query, jsonCompactPrint(_answer));
+}
+
+Json::Value QueryCache::toJson(CheckResult _result)
+{
+	return checkResultNames.at(_result);
+}
+
+Json::Value QueryCache::toJson(Expression const& _expr)
+{
+	Json::Value json{Json::objectValue};
+	json["name"] = _expr.name;
+	smtAssert(_expr.sort);
+	json["sort"] = toJson(*_expr.sort);
+	if (!_expr.arguments.empty())
+	{
+		json["arguments"] = Json::arrayValue;
+		for (auto const& argument: _expr.arguments)
+			json["arguments"].append(toJson(argument));
+	}
+	return json;
+}
+
+Json::Value QueryCache::toJson(Sort const& _sort)
+{
+	Json::Value json{Json::objectValue};
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		json["kind"] = "int";
+		json["signed"] = dynamic_cast<IntSort const&>(_sort).isSigned;
+		break;
+	case Kind::Bool:
+		json["kind"] = "bool";
+		break;
+	case Kind::BitVector:
+		json["kind"] = "bitvector";
+		json["size"] = dynamic_cast<BitVectorSort const&>(_sort).size;
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		json["kind"] = "function";
+		json["domain"] = Json::arrayValue;
+		for (auto const& sort: functionSort.domain)
+			json["domain"].append(toJson(*sort));
+		json["codomain"] = toJson(*functionSort.codomain);
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		json["kind"] = "array";
+		json["domain"] = toJson(*arraySort.domain);
+		json["range"] = toJson(*arraySort.range);
+		break;
+	}
+	case Kind::Sort:
+		json["kind"] = "sort";
+		json["inner"] = toJson(*dynamic_cast<SortSort const&>(_sort).inner);
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		json["kind"] = "tuple";
+		json["name"] = tupleSort.name;
+		json["members"] = Json::arrayValue;
+		for (auto const& member: tupleSort.members)
+			json["members"].append(member);
+		json["components"] = Json::arrayValue;
+		for (auto const& sort: tupleSort.components)
+			json["components"].append(toJson(*sort));
+		break;
+	}
+	}
+	return json;
+}
+
+std::optional<CheckResult> QueryCache::checkResultFromJson(Json::Value const& _json)
+{
+	for (auto const& [result, name]: checkResultNames)
+		if (_json.isString() && _json.asString() == name)
+			return result;
+	return std::nullopt;
+}
+
+std::optional<Expression> QueryCache::expressionFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["name"].isString())
+		return std::nullopt;
+	SortPointer sort = sortFromJson(_json["sort"]);
+	if (!sort)
+		return std::nullopt;
+	std::vector<Expression> arguments;
+	if (_json.isMember("arguments"))
+	{
+		if (!_json["arguments"].isArray())
+			return std::nullopt;
+		for (auto const& argumentJson: _json["arguments"])
+			if (auto argument = expressionFromJson(argumentJson))
+				arguments.push_back(std::move(*argument));
+			else
+				return std::nullopt;
+	}
+	return Expression(_json["name"].asString(), std::move(arguments), std::move(sort));
+}
+
+SortPointer QueryCache::sortFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["kind"].isString())
+		return nullptr;
+	auto sortsFromJson = [](Json::Value const& _sorts) -> std::optional<std::vector<SortPointer>> {
+		if (!_sorts.isArray())
+			return std::nullopt;
+		std::vector<SortPointer> sorts;
+		for (auto const& sortJson: _sorts)
+			if (auto sort = sortFromJson(sortJson))
+				sorts.push_back(std::move(sort));
+			else
+				return std::nullopt;
+		return sorts;
+	};
+
+	std::string const kind = _json["kind"].asString();
+	if (kind == "int" && _json["signed"].isBool())
+		return SortProvider::intSort(_json["signed"].asBool());
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bitvector" && _json["size"].isUInt())
+		return std::make_shared<BitVectorSort>(_json["size"].asUInt());
+	else if (kind == "function")
+	{
+		auto domain = sortsFromJson(_json["domain"]);
+		auto codomain = sortFromJson(_json["codomain"]);
+		if (domain && codomain)
+			return std::make_shared<FunctionSort>(std::move(*domain), std::move(codomain));
+	}
+	else if (kind == "array")
+	{
+		auto domain = sortFromJson(_json["domain"]);
+		auto range = sortFromJson(_json["range"]);
+		if (domain && range)
+			return std::make_shared<ArraySort>(std::move(domain), std::move(range));
+	}
+	else if (kind == "sort")
+	{
+		if (auto inner = sortFromJson(_json["inner"]))
+			return std::make_shared<SortSort>(std::move(inner));
+	}
+	else if (kind == "tuple" && _json["name"].isString() && _json["members"].isArray())
+	{
+		std::vector<std::string> members;
+		for (auto const& member: _json["members"])
+			if (member.isString())
+				members.push_back(member.asString());
+			else
+				return nullptr;
+		auto components = sortsFromJson(_json["components"]);
+		if (components && components->size() == members.size())
+			return std::make_shared<TupleSort>(_json["name"].asString(), std::move(members), std::move(*components));
+	}
+	return nullptr;
+}
+
+boost::filesystem::path QueryCache::entryPath(std::string const& _solver, std::string const& _query) const
+{
+	return m_directory / keccak256(_solver + "\n" + _query).hex();
+}
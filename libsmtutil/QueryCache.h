@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Persistent cache of solver answers.
+ * Every answer is stored in its own file in the cache directory, named after
+ * the keccak256 hash of the identity of the solver and the query.
+ * The identity of a solver has to contain everything besides the query
+ * that influences its answer, such as its name, version and timeout.
+ * The cache is safe to use from several threads and processes at the same time.
+ * Failures to read or write the cache are ignored and malformed answers are treated
+ * as missing.
+ */
+class QueryCache
+{
+public:
+	explicit QueryCache(boost::filesystem::path _directory);
+
+	/// @returns the answer stored for @a _query to the solver @a _solver, if any.
+	std::optional<std::string> lookup(std::string const& _solver, std::string const& _query) const;
+	/// @returns the answer stored for @a _query to the solver @a _solver, if any and if it is valid JSON.
+	std::optional<Json::Value> lookupJson(std::string const& _solver, std::string const& _query) const;
+	/// Stores @a _answer to @a _query, replacing any previous answer.
+	void store(std::string const& _solver, std::string const& _query, std::string const& _answer) const;
+	void store(std::string const& _solver, std::string const& _query, Json::Value const& _answer) const;
+
+	/// Conversion of the parts of answers to and from JSON.
+	/// The conversions from JSON return nullopt or nullptr if the JSON is malformed.
+	//@{
+	static Json::Value toJson(CheckResult _result);
+	static Json::Value toJson(Expression const& _expr);
+	static Json::Value toJson(Sort const& _sort);
+	static std::optional<CheckResult> checkResultFromJson(Json::Value const& _json);
+	static std::optional<Expression> expressionFromJson(Json::Value const& _json);
+	static SortPointer sortFromJson(Json::Value const& _json);
+	//@}
+
+private:
+	boost::filesystem::path entryPath(std::string const& _solver, std::string const& _query) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -18,6 +18,8 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -41,11 +43,13 @@ using namespace solidity::smtutil;
 SMTLib2Interface::SMTLib2Interface(
 	std::map<h256, std::string> _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _solverSession
 ):
 	SolverInterface(_queryTimeout),
 	m_queryResponses(std::move(_queryResponses)),
-	m_smtCallback(std::move(_smtCallback))
+	m_smtCallback(std::move(_smtCallback)),
+	m_solverSession(_solverSession)
 {
 	reset();
 }
@@ -54,6 +58,8 @@ void SMTLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
+	m_scopeIds = {m_nextScopeId++};
+	m_sessionScopes.clear();
 	m_variables.clear();
 	m_userSorts.clear();
 	write("(set-option :produce-models true)");
@@ -65,12 +71,14 @@ void SMTLib2Interface::reset()
 void SMTLib2Interface::push()
 {
 	m_accumulatedOutput.emplace_back();
+	m_scopeIds.push_back(m_nextScopeId++);
 }
 
 void SMTLib2Interface::pop()
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
 	m_accumulatedOutput.pop_back();
+	m_scopeIds.pop_back();
 }
 
 void SMTLib2Interface::declareVariable(std::string const& _name, SortPointer const& _sort)
@@ -115,10 +123,9 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 std::pair<CheckResult, std::vector<std::string>> SMTLib2Interface::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
-	std::string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	// The command may declare sorts, so it has to be created before the output is joined.
+	std::string command = checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	std::string response = querySolver(boost::algorithm::join(m_accumulatedOutput, "\n") + command, command);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -138,15 +145,58 @@ std::pair<CheckResult, std::vector<std::string>> SMTLib2Interface::check(std::ve
 }
 
 std::string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	SharedTerms shared;
+	countOccurrences(_expr, shared.occurrences);
+	std::string body = toSExpr(_expr, shared);
+	if (shared.bindings.empty())
+		return body;
+
+	// Bindings may refer to the ones before them, so each one gets its own let.
+	std::string sexpr;
+	for (auto const& [name, definition]: shared.bindings)
+		sexpr += "(let ((" + name + " " + definition + ")) ";
+	return sexpr + body + std::string(shared.bindings.size(), ')');
+}
+
+void SMTLib2Interface::countOccurrences(Expression const& _expr, std::map<Expression::SharingKey, size_t>& _occurrences)
+{
+	// Only copies of an application share its arguments.
+	if (_expr.arguments.shared() && _occurrences[_expr.sharingKey()]++ > 0)
+		return;
+	for (auto const& arg: _expr.arguments)
+		countOccurrences(arg, _occurrences);
+}
+
+std::string SMTLib2Interface::toSExpr(Expression const& _expr, SharedTerms& _shared)
 {
 	if (_expr.arguments.empty())
 		return _expr.name;
+	if (!_expr.arguments.shared())
+		return applicationToSExpr(_expr, _shared);
+
+	auto key = _expr.sharingKey();
+	if (auto it = _shared.conversions.find(key); it != _shared.conversions.end())
+		return it->second;
+	std::string sexpr = applicationToSExpr(_expr, _shared);
+	size_t occurrences = _shared.occurrences.at(key);
+	std::string name = "_s!" + std::to_string(_shared.bindings.size());
+	// A binding costs "(let ((<name> <sexpr>)) " and a closing parenthesis.
+	if (occurrences * sexpr.size() > sexpr.size() + 12 + (occurrences + 1) * name.size())
+	{
+		_shared.bindings.emplace_back(name, std::move(sexpr));
+		sexpr = std::move(name);
+	}
+	return _shared.conversions[std::move(key)] = std::move(sexpr);
+}
 
+std::string SMTLib2Interface::applicationToSExpr(Expression const& _expr, SharedTerms& _shared)
+{
 	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
-		auto arg = toSExpr(_expr.arguments.front());
+		auto arg = toSExpr(_expr.arguments.front(), _shared);
 		auto int2bv = "(_ int2bv " + std::to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
 		sexpr += std::string("ite ") +
@@ -159,7 +209,7 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto intSort = std::dynamic_pointer_cast<IntSort>(_expr.sort);
 		smtAssert(intSort, "");
 
-		auto arg = toSExpr(_expr.arguments.front());
+		auto arg = toSExpr(_expr.arguments.front(), _shared);
 		auto nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
@@ -184,7 +234,7 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
 		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		sexpr += toSExpr(_expr.arguments.at(1), _shared);
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -192,7 +242,7 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0), _shared);
 	}
 	else if (_expr.name == "tuple_constructor")
 	{
@@ -200,13 +250,13 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(tupleSort, "");
 		sexpr += "|" + tupleSort->name + "|";
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+			sexpr += " " + toSExpr(arg, _shared);
 	}
 	else
 	{
 		sexpr += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+			sexpr += " " + toSExpr(arg, _shared);
 	}
 	sexpr += ")";
 	return sexpr;
@@ -307,21 +357,101 @@ std::vector<std::string> SMTLib2Interface::parseValues(std::string::const_iterat
 	return values;
 }
 
-std::string SMTLib2Interface::querySolver(std::string const& _input)
+std::string SMTLib2Interface::querySolver(std::string const& _input, std::optional<std::string> const& _command)
 {
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	// The solver behind the callback is unknown, the timeout is part of the query.
+	std::string const solver = "smtlib2";
+	if (m_queryCache)
+		// Only answers are stored, anything else is treated as missing.
+		if (
+			auto response = m_queryCache->lookup(solver, _input);
+			response && (boost::starts_with(*response, "sat") || boost::starts_with(*response, "unsat"))
+		)
+			return *response;
 	if (m_smtCallback)
 	{
-		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		std::optional<ReadCallback::Result> sessionResult;
+		if (m_solverSession && _command)
+			sessionResult = querySession(*_command);
+		auto result = sessionResult && sessionResult->success ?
+			std::move(*sessionResult) :
+			m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+		{
+			auto const& response = result.responseOrErrorMessage;
+			if (m_queryCache && (boost::starts_with(response, "sat") || boost::starts_with(response, "unsat")))
+				m_queryCache->store(solver, _input, response);
+			return response;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
 
+ReadCallback::Result SMTLib2Interface::querySession(std::string const& _command)
+{
+	// The scopes are compared by id, because a scope that was popped and pushed again
+	// has the same position but different content.
+	size_t common = 0;
+	while (
+		common < m_sessionScopes.size() &&
+		common < m_scopeIds.size() &&
+		m_sessionScopes[common].first == m_scopeIds[common]
+	)
+		++common;
+
+	std::string commands;
+	if (common == 0)
+	{
+		m_sessionScopes.clear();
+		commands += "(reset)\n";
+	}
+	else if (common < m_sessionScopes.size())
+	{
+		commands += "(pop " + std::to_string(m_sessionScopes.size() - common) + ")\n";
+		m_sessionScopes.resize(common);
+	}
+
+	for (size_t i = 0; i < m_accumulatedOutput.size(); ++i)
+	{
+		std::string const& scope = m_accumulatedOutput[i];
+		if (i < common)
+			commands += scope.substr(m_sessionScopes[i].second);
+		else
+		{
+			if (i > 0)
+				commands += "(push 1)\n";
+			commands += scope;
+			m_sessionScopes.emplace_back(m_scopeIds[i], 0);
+		}
+		m_sessionScopes[i].second = scope.size();
+	}
+	// The command declares constants, which must not stay in the solver.
+	commands += "(push 1)\n" + _command + "(pop 1)\n";
+
+	auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTSession), commands);
+	// Only the check prints its result, so anything before it is an error reported for
+	// an earlier command, which the solver then does not know about.
+	if (
+		result.success &&
+		!boost::starts_with(result.responseOrErrorMessage, "sat\n") &&
+		!boost::starts_with(result.responseOrErrorMessage, "unsat\n") &&
+		!boost::starts_with(result.responseOrErrorMessage, "unknown\n")
+	)
+		result.success = false;
+	if (!result.success)
+	{
+		// The callback does not support sessions, the solver stopped or rejected a command,
+		// so this and the remaining queries are sent in full.
+		m_solverSession = false;
+		m_sessionScopes.clear();
+	}
+	return result;
+}
+
 std::string SMTLib2Interface::dumpQuery(std::vector<Expression> const& _expressionsToEvaluate)
 {
 	return boost::algorithm::join(m_accumulatedOutput, "\n") +
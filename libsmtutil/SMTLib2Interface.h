@@ -44,7 +44,8 @@ public:
 	explicit SMTLib2Interface(
 		std::map<util::h256, std::string> _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _solverSession = false
 	);
 
 	void reset() override;
@@ -71,6 +72,23 @@ public:
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
 private:
+	/// Applications that occur several times in the expression being converted.
+	struct SharedTerms
+	{
+		/// Number of occurrences, counted without descending into repeated occurrences.
+		std::map<Expression::SharingKey, size_t> occurrences;
+		/// Conversion of each application converted so far, or the name it is bound to.
+		std::map<Expression::SharingKey, std::string> conversions;
+		/// Names and conversions of the bound applications, in the order they have to be bound in.
+		std::vector<std::pair<std::string, std::string>> bindings;
+	};
+
+	static void countOccurrences(Expression const& _expr, std::map<Expression::SharingKey, size_t>& _occurrences);
+	/// Converts @a _expr, binding the repeated applications in @a _shared to names
+	/// where this is shorter than printing them each time.
+	std::string toSExpr(Expression const& _expr, SharedTerms& _shared);
+	std::string applicationToSExpr(Expression const& _expr, SharedTerms& _shared);
+
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
 	void write(std::string _data);
@@ -79,9 +97,17 @@ private:
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
+	/// If @a _command is given and the solver session is enabled, only the commands the
+	/// session has not seen yet are sent, followed by @a _command.
+	std::string querySolver(std::string const& _input, std::optional<std::string> const& _command = {});
+	/// Sends the part of the accumulated output that the solver session has not seen yet
+	/// and @a _command in a scope of its own.
+	frontend::ReadCallback::Result querySession(std::string const& _command);
 
 	std::vector<std::string> m_accumulatedOutput;
+	/// Unique ids of the scopes in m_accumulatedOutput.
+	std::vector<size_t> m_scopeIds;
+	size_t m_nextScopeId = 0;
 	std::map<std::string, SortPointer> m_variables;
 
 	/// Each pair in this vector represents an SMTChecker created
@@ -94,6 +120,11 @@ private:
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+
+	/// If true, queries are sent incrementally to the solver session of the callback.
+	bool m_solverSession = false;
+	/// The scopes that the solver session has, by their id and the length sent of each of them.
+	std::vector<std::pair<size_t, size_t>> m_sessionScopes;
 };
 
 }
@@ -26,6 +26,13 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -36,13 +43,18 @@ SMTPortfolio::SMTPortfolio(
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
 	std::optional<unsigned> _queryTimeout,
-	bool _printQuery
+	bool _printQuery,
+	bool _crossCheckSolvers,
+	bool _solverSession
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_crossCheckSolvers(_crossCheckSolvers)
 {
 	solAssert(!_printQuery || _enabledSolvers == smtutil::SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
 	if (_enabledSolvers.smtlib2)
-		m_solvers.emplace_back(std::make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout));
+		m_solvers.emplace_back(std::make_unique<SMTLib2Interface>(
+			std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout, _solverSession
+		));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
 		m_solvers.emplace_back(std::make_unique<Z3Interface>(m_queryTimeout));
@@ -95,16 +107,24 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  * A solver did not answer the query if it returns either:
  *   UNKNOWN (it tried but couldn't solve it) or ERROR (crash, internal error, API error, etc).
  *
- * Ideally all solvers answer the query and agree on what the answer is
- * (all say SAT or all say UNSAT).
+ * The solvers run concurrently. By default, the answer of the first solver in the order of the
+ * portfolio that answers the query decides the result. Once it is known, the solvers after it
+ * are interrupted, which makes them return UNKNOWN. The answer of a solver is only used when
+ * all solvers before it have finished without answering, so that the result and its model do
+ * not depend on which solver happens to be fastest. The SMT-LIB2 solver cannot be interrupted
+ * and records the queries it could not answer, so it is always run to completion outside the race.
+ *
+ * If the answers are cross-checked, all solvers run to completion. Ideally all solvers
+ * answer the query and agree on what the answer is (all say SAT or all say UNSAT).
  *
  * The actual logic as as follows:
  * 1) If at least one solver answers the query, all the non-answer results are ignored.
  *   Here SAT/UNSAT is preferred over UNKNOWN since it's an actual answer, and over ERROR
- *   because one buggy solver/integration shouldn't break the portfolio.
+ *   because one buggy solver/integration shouldn't break the portfolio. By default, exceptions
+ *   thrown by the other solvers are ignored as well.
  *
- * 2) If at least one solver answers SAT and at least one answers UNSAT, at least one of them is buggy
- * and the result is CONFLICTING.
+ * 2) If the answers are cross-checked and at least one solver answers SAT and at least one
+ * answers UNSAT, at least one of them is buggy and the result is CONFLICTING.
  *   In the future if we have more than 2 solvers enabled we could go with the majority.
  *
  * 3) If NO solver answers the query:
@@ -116,28 +136,100 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	if (m_solvers.size() == 1)
+		return m_solvers.front()->check(_expressionsToEvaluate);
+
+	std::mutex mutex;
+	std::condition_variable solverFinished;
+	std::vector<std::optional<std::pair<CheckResult, std::vector<std::string>>>> results(m_solvers.size());
+	std::vector<std::exception_ptr> exceptions(m_solvers.size());
+
+	auto const checkWithSolver = [&](size_t _index) {
+		std::pair<CheckResult, std::vector<std::string>> result{CheckResult::ERROR, {}};
+		std::exception_ptr exception;
+		try
+		{
+			result = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			results[_index] = std::move(result);
+			exceptions[_index] = std::move(exception);
+		}
+		solverFinished.notify_all();
+	};
+	// @returns true if the solvers that have finished so far determine the result, i.e. if
+	// one of them answered and all solvers before it have finished, or if all have finished.
+	auto const resultDetermined = [&]() {
+		for (auto const& result: results)
+			if (!result)
+				return false;
+			else if (!m_crossCheckSolvers && solverAnswered(result->first))
+				return true;
+		return true;
+	};
+
+	// The default launch policy falls back to deferred execution if no threads are available,
+	// in which case the solvers are queried one after the other.
+	std::vector<std::future<void>> checks(m_solvers.size());
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (!dynamic_cast<SMTLib2Interface*>(m_solvers[i].get()))
+			checks[i] = std::async(checkWithSolver, i);
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (!checks[i].valid())
+			checkWithSolver(i);
+	for (auto& check: checks)
+		if (check.valid() && check.wait_for(std::chrono::seconds(0)) == std::future_status::deferred)
+			check.get();
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		solverFinished.wait(lock, resultDetermined);
+	}
+	// A solver may be interrupted right before it starts checking, which has no effect,
+	// so the interruption is repeated until it returns.
+	for (size_t i = 0; i < checks.size(); ++i)
+		if (checks[i].valid())
+		{
+			while (checks[i].wait_for(std::chrono::milliseconds(10)) != std::future_status::ready)
+				m_solvers[i]->interrupt();
+			checks[i].get();
+		}
+
+	if (!m_crossCheckSolvers)
+		for (auto& result: results)
+			if (solverAnswered(result->first))
+				return std::move(*result);
+
+	for (std::exception_ptr const& exception: exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& result: results)
 	{
-		CheckResult result;
-		std::vector<std::string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		auto&& [checkResult, values] = *result;
+		if (solverAnswered(checkResult))
 		{
 			if (!solverAnswered(lastResult))
 			{
-				lastResult = result;
+				lastResult = checkResult;
 				finalValues = std::move(values);
 			}
-			else if (lastResult != result)
+			else if (lastResult != checkResult)
 			{
 				lastResult = CheckResult::CONFLICTING;
 				break;
 			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
+		else if (checkResult == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+			lastResult = checkResult;
 	}
 	return std::make_pair(lastResult, finalValues);
 }
@@ -152,6 +244,12 @@ std::vector<std::string> SMTPortfolio::unhandledQueries()
 	return {};
 }
 
+void SMTPortfolio::setQueryCache(std::shared_ptr<QueryCache> _queryCache)
+{
+	for (auto const& s: m_solvers)
+		s->setQueryCache(_queryCache);
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
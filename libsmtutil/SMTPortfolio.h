@@ -32,8 +32,10 @@ namespace solidity::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * Queries are checked by all solvers concurrently. By default, the first
+ * solver of the portfolio that answers decides the result and the solvers
+ * after it are interrupted. Alternatively, it waits for all solvers and
+ * checks whether they give conflicting answers to SMT queries.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -47,7 +49,9 @@ public:
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
 		std::optional<unsigned> _queryTimeout = {},
-		bool _printQuery = false
+		bool _printQuery = false,
+		bool _crossCheckSolvers = false,
+		bool _solverSession = false
 	);
 
 	void reset() override;
@@ -64,12 +68,16 @@ public:
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 
+	void setQueryCache(std::shared_ptr<QueryCache> _queryCache) override;
+
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
 private:
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// If true, the answers of all solvers are compared instead of taking the first one.
+	bool m_crossCheckSolvers = false;
 
 	std::vector<Expression> m_assertions;
 };
@@ -34,6 +34,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace solidity::smtutil
@@ -114,7 +115,50 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+/// Immutable vector whose copies share their elements.
+/// Copying it takes constant time and it can be read from several threads at once.
+template <typename T>
+class SharedVector
+{
+public:
+	using value_type = T;
+	using const_iterator = typename std::vector<T>::const_iterator;
+	using iterator = const_iterator;
+
+	SharedVector() = default;
+	SharedVector(std::vector<T> _elements):
+		m_elements(_elements.empty() ? nullptr : std::make_shared<std::vector<T> const>(std::move(_elements)))
+	{}
+
+	operator std::vector<T> const&() const { return m_elements ? *m_elements : emptyVector(); }
+
+	const_iterator begin() const { return static_cast<std::vector<T> const&>(*this).begin(); }
+	const_iterator end() const { return static_cast<std::vector<T> const&>(*this).end(); }
+	size_t size() const { return m_elements ? m_elements->size() : 0; }
+	bool empty() const { return !m_elements; }
+	T const& at(size_t _index) const { return static_cast<std::vector<T> const&>(*this).at(_index); }
+	T const& operator[](size_t _index) const { return at(_index); }
+	T const& front() const { return at(0); }
+	T const& back() const { return at(size() - 1); }
+
+	/// @returns true if the elements are also referenced by another copy.
+	bool shared() const { return m_elements.use_count() > 1; }
+	/// @returns an address that is the same for all copies and unique among the live vectors.
+	void const* identity() const { return m_elements.get(); }
+
+private:
+	static std::vector<T> const& emptyVector()
+	{
+		static std::vector<T> const empty;
+		return empty;
+	}
+
+	std::shared_ptr<std::vector<T> const> m_elements;
+};
+
 /// C++ representation of an SMTLIB2 expression.
+/// The arguments are shared between copies, so that a formula is a DAG in which
+/// subexpressions that occur several times are only stored once.
 class Expression
 {
 	friend class SolverInterface;
@@ -484,8 +528,13 @@ public:
 		return Expression(name, std::move(_arguments), fSort->codomain);
 	}
 
+	/// Key that is equal for all copies of an application, as long as one of them is alive.
+	/// Used to convert subexpressions that occur several times in a formula only once.
+	using SharingKey = std::tuple<void const*, std::string, Sort const*>;
+	SharingKey sharingKey() const { return {arguments.identity(), name, sort.get()}; }
+
 	std::string name;
-	std::vector<Expression> arguments;
+	SharedVector<Expression> arguments;
 	SortPointer sort;
 
 private:
@@ -509,6 +558,8 @@ private:
 
 DEV_SIMPLE_EXCEPTION(SolverError);
 
+class QueryCache;
+
 class SolverInterface
 {
 public:
@@ -536,14 +587,23 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a running call to check() to stop as soon as possible, in which case it returns UNKNOWN.
+	/// May be called from another thread than check(). Has no effect if the solver cannot be interrupted.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
+	/// Sets the persistent cache of answers to queries.
+	/// Solvers that do not support it ignore it.
+	virtual void setQueryCache(std::shared_ptr<QueryCache> _queryCache) { m_queryCache = std::move(_queryCache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache> m_queryCache;
 };
 
 }
@@ -18,7 +18,10 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Visitor.h>
 
 #include <set>
 #include <stack>
@@ -53,16 +56,19 @@ Z3CHCInterface::Z3CHCInterface(std::optional<unsigned> _queryTimeout):
 void Z3CHCInterface::declareVariable(std::string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	m_history.emplace_back(Declaration{_name, _sort});
 	m_z3Interface->declareVariable(_name, _sort);
 }
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_history.emplace_back(Relation{_expr});
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, std::string const& _name)
 {
+	m_history.emplace_back(Rule{_expr, _name});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -77,6 +83,27 @@ void Z3CHCInterface::addRule(Expression const& _expr, std::string const& _name)
 }
 
 std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	std::string query;
+	if (m_queryCache)
+	{
+		z3::expr_vector queries(*m_context);
+		queries.push_back(m_z3Interface->toZ3Expr(_expr));
+		query = m_solver.to_string(queries);
+		if (auto answer = m_queryCache->lookupJson(cacheIdentity(), query))
+			if (auto cachedAnswer = answerFromJson(*answer))
+				return std::move(*cachedAnswer);
+	}
+
+	auto answer = solve(_expr);
+	CheckResult result = std::get<0>(answer);
+	// Unknown only depends on the query if there is no timeout.
+	if (m_queryCache && result != CheckResult::ERROR && (result != CheckResult::UNKNOWN || !m_queryTimeout))
+		m_queryCache->store(cacheIdentity(), query, answerToJson(answer));
+	return answer;
+}
+
+std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::solve(Expression const& _expr)
 {
 	CheckResult result;
 	try
@@ -148,6 +175,93 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	p.set("fp.xform.inline_eager", _preProcessing);
 
 	m_solver.set(p);
+	m_preProcessing = _preProcessing;
+}
+
+std::unique_ptr<Z3CHCInterface> Z3CHCInterface::copy() const
+{
+	auto solver = std::make_unique<Z3CHCInterface>(m_queryTimeout);
+	for (auto const& command: m_history)
+		std::visit(util::GenericVisitor{
+			[&](Declaration const& _declaration) { solver->declareVariable(_declaration.name, _declaration.sort); },
+			[&](Relation const& _relation) { solver->registerRelation(_relation.relation); },
+			[&](Rule const& _rule) { solver->addRule(_rule.rule, _rule.name); }
+		}, command);
+	solver->setQueryCache(m_queryCache);
+	return solver;
+}
+
+std::string Z3CHCInterface::cacheIdentity() const
+{
+	return m_z3Interface->cacheIdentity() + " spacer" + (m_preProcessing ? "" : " without preprocessing");
+}
+
+Json::Value Z3CHCInterface::answerToJson(std::tuple<CheckResult, Expression, CexGraph> const& _answer)
+{
+	auto const& [result, invariant, cex] = _answer;
+	Json::Value json{Json::objectValue};
+	json["result"] = QueryCache::toJson(result);
+	json["invariant"] = QueryCache::toJson(invariant);
+	json["nodes"] = Json::arrayValue;
+	for (auto const& [id, node]: cex.nodes)
+	{
+		Json::Value entry{Json::arrayValue};
+		entry.append(id);
+		entry.append(QueryCache::toJson(node));
+		json["nodes"].append(std::move(entry));
+	}
+	json["edges"] = Json::arrayValue;
+	for (auto const& [id, children]: cex.edges)
+	{
+		Json::Value entry{Json::arrayValue};
+		entry.append(id);
+		Json::Value childIds{Json::arrayValue};
+		for (unsigned child: children)
+			childIds.append(child);
+		entry.append(std::move(childIds));
+		json["edges"].append(std::move(entry));
+	}
+	return json;
+}
+
+std::optional<std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> Z3CHCInterface::answerFromJson(
+	Json::Value const& _json
+)
+{
+	if (!_json.isObject() || !_json["nodes"].isArray() || !_json["edges"].isArray())
+		return std::nullopt;
+	auto isPair = [](Json::Value const& _entry) {
+		return _entry.isArray() && _entry.size() == 2 && _entry[0].isUInt();
+	};
+
+	CexGraph cex;
+	for (auto const& entry: _json["nodes"])
+	{
+		if (!isPair(entry))
+			return std::nullopt;
+		auto node = QueryCache::expressionFromJson(entry[1]);
+		if (!node)
+			return std::nullopt;
+		cex.nodes.emplace(entry[0].asUInt(), std::move(*node));
+	}
+	for (auto const& entry: _json["edges"])
+	{
+		if (!isPair(entry) || !entry[1].isArray())
+			return std::nullopt;
+		auto& children = cex.edges[entry[0].asUInt()];
+		for (auto const& child: entry[1])
+		{
+			if (!child.isUInt())
+				return std::nullopt;
+			children.push_back(child.asUInt());
+		}
+	}
+
+	auto result = QueryCache::checkResultFromJson(_json["result"]);
+	auto invariant = QueryCache::expressionFromJson(_json["invariant"]);
+	if (!result || !invariant)
+		return std::nullopt;
+	return std::make_tuple(*result, std::move(*invariant), std::move(cex));
 }
 
 /**
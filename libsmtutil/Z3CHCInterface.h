@@ -25,7 +25,12 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsolutil/JSON.h>
+
+#include <memory>
+#include <optional>
 #include <tuple>
+#include <variant>
 #include <vector>
 
 namespace solidity::smtutil
@@ -49,7 +54,21 @@ public:
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// @returns a Horn solver with its own Z3 context that contains
+	/// the same declarations, relations and rules as this one.
+	/// Different copies can be queried concurrently.
+	std::unique_ptr<Z3CHCInterface> copy() const;
+
 private:
+	/// Queries z3 without looking at the query cache.
+	std::tuple<CheckResult, Expression, CexGraph> solve(Expression const& _expr);
+
+	/// @returns the identity of this solver in the query cache.
+	std::string cacheIdentity() const;
+	static Json::Value answerToJson(std::tuple<CheckResult, Expression, CexGraph> const& _answer);
+	/// @returns nullopt if @a _json is not a valid answer.
+	static std::optional<std::tuple<CheckResult, Expression, CexGraph>> answerFromJson(Json::Value const& _json);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -66,6 +85,28 @@ private:
 	// Horn solver.
 	z3::fixedpoint m_solver;
 
+	struct Declaration
+	{
+		std::string name;
+		SortPointer sort;
+	};
+	struct Relation
+	{
+		Expression relation;
+	};
+	struct Rule
+	{
+		Expression rule;
+		std::string name;
+	};
+	/// Declarations, relations and rules in the order they were given, used to create copies.
+	/// The order matters, because a variable can be redeclared and every rule is quantified
+	/// over the variables declared before it.
+	std::vector<std::variant<Declaration, Relation, Rule>> m_history;
+
+	/// Whether Spacer's preprocessing is enabled, which influences its answers.
+	bool m_preProcessing = true;
+
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
 };
 
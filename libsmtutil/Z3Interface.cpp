@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
@@ -96,8 +98,31 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	std::string query;
+	if (m_queryCache)
+	{
+		query = m_solver.to_smt2();
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "\n" + util::toString(toZ3Expr(e));
+		if (auto answer = m_queryCache->lookupJson(cacheIdentity(), query); answer && answer->isObject())
+		{
+			// Malformed answers are treated as missing.
+			std::optional<CheckResult> result = QueryCache::checkResultFromJson((*answer)["result"]);
+			Json::Value const& valuesJson = (*answer)["values"];
+			std::vector<std::string> values;
+			if (valuesJson.isArray())
+				for (auto const& value: valuesJson)
+					if (value.isString())
+						values.push_back(value.asString());
+			if (result && valuesJson.isArray() && values.size() == valuesJson.size())
+				return {*result, std::move(values)};
+		}
+	}
+
 	CheckResult result;
 	std::vector<std::string> values;
+	// Only answers that do not depend on timing are cached.
+	bool deterministic = true;
 	try
 	{
 		switch (m_solver.check())
@@ -110,6 +135,8 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 			break;
 		case z3::check_result::unknown:
 			result = CheckResult::UNKNOWN;
+			// Unknown only depends on the query if it was neither interrupted nor timed out.
+			deterministic = !m_queryTimeout && std::string(m_solver.reason_unknown()) != "canceled";
 			break;
 		}
 
@@ -133,19 +160,70 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 			result = CheckResult::UNKNOWN;
 		else
 			result = CheckResult::ERROR;
+		deterministic = !m_queryTimeout && std::string(_err.msg()) == "max. resource limit exceeded";
 		values.clear();
 	}
 
+	if (m_queryCache && deterministic && result != CheckResult::ERROR)
+	{
+		Json::Value answer{Json::objectValue};
+		answer["result"] = QueryCache::toJson(result);
+		answer["values"] = Json::arrayValue;
+		for (auto const& value: values)
+			answer["values"].append(value);
+		m_queryCache->store(cacheIdentity(), query, answer);
+	}
+
 	return std::make_pair(result, values);
 }
 
+std::string Z3Interface::cacheIdentity() const
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	std::string identity =
+		"z3 " + std::to_string(major) + "." + std::to_string(minor) + "." +
+		std::to_string(build) + "." + std::to_string(revision);
+	if (m_queryTimeout)
+		return identity + " timeout " + std::to_string(*m_queryTimeout);
+	else
+		return identity + " rlimit " + std::to_string(resourceLimit);
+}
+
+void Z3Interface::interrupt()
+{
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	std::map<Expression::SharingKey, z3::expr> shared;
+	return toZ3Expr(_expr, shared);
+}
+
+z3::expr Z3Interface::toZ3Expr(Expression const& _expr, std::map<Expression::SharingKey, z3::expr>& _shared)
+{
+	if (!_expr.arguments.shared())
+		return convertToZ3(_expr, _shared);
+
+	auto key = _expr.sharingKey();
+	if (auto it = _shared.find(key); it != _shared.end())
+		return it->second;
+	z3::expr result = convertToZ3(_expr, _shared);
+	_shared.emplace(std::move(key), result);
+	return result;
+}
+
+z3::expr Z3Interface::convertToZ3(Expression const& _expr, std::map<Expression::SharingKey, z3::expr>& _shared)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
 	z3::expr_vector arguments(m_context);
 	for (auto const& arg: _expr.arguments)
-		arguments.push_back(toZ3Expr(arg));
+		arguments.push_back(toZ3Expr(arg, _shared));
 
 	try
 	{
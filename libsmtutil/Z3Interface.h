@@ -44,6 +44,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -53,11 +54,20 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the version of z3 and the limits of queries, which identify
+	/// the solver in the query cache.
+	std::string cacheIdentity() const;
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
 
 private:
+	/// Converts @a _expr, reusing the conversions in @a _shared of subexpressions
+	/// whose arguments are shared with other expressions.
+	z3::expr toZ3Expr(Expression const& _expr, std::map<Expression::SharingKey, z3::expr>& _shared);
+	z3::expr convertToZ3(Expression const& _expr, std::map<Expression::SharingKey, z3::expr>& _shared);
+
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
 	z3::sort z3Sort(Sort const& _sort);
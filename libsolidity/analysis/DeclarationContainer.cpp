@@ -41,10 +41,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	std::vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto const* visible = util::valueOrNullptr(m_declarations, *_name))
+		declarations += *visible;
+	if (auto const* invisible = util::valueOrNullptr(m_invisibleDeclarations, *_name))
+		declarations += *invisible;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -149,25 +149,31 @@ std::vector<Declaration const*> DeclarationContainer::resolveName(
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	std::vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	// Walk up the enclosing containers iteratively instead of recursively, looking up the name
+	// only once per container.
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
 	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_declarations.at(_name);
-	}
+		if (auto const* declarations = util::valueOrNullptr(container->m_declarations, _name))
+		{
+			if (_settings.onlyVisibleAsUnqualifiedNames)
+				result += *declarations | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			else
+				result += *declarations;
+		}
 
-	if (_settings.alsoInvisible && m_invisibleDeclarations.count(_name))
-	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_invisibleDeclarations.at(_name);
+		if (_settings.alsoInvisible)
+			if (auto const* declarations = util::valueOrNullptr(container->m_invisibleDeclarations, _name))
+			{
+				if (_settings.onlyVisibleAsUnqualifiedNames)
+					result += *declarations | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+				else
+					result += *declarations;
+			}
+
+		if (!result.empty() || !_settings.recursive)
+			break;
 	}
 
-	if (result.empty() && _settings.recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, _settings);
-
 	return result;
 }
 
@@ -26,6 +26,7 @@
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ErrorReporter.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
 #include <boost/algorithm/string.hpp>
 #include <unordered_set>
@@ -351,55 +352,67 @@ bool NameAndTypeResolver::resolveNamesAndTypesInternal(ASTNode& _node, bool _res
 	}
 }
 
-void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
+std::vector<Declaration const*> const& NameAndTypeResolver::inheritableDeclarations(ContractDefinition const& _base)
 {
+	if (auto const* declarations = util::valueOrNullptr(m_inheritableDeclarations, &_base))
+		return *declarations;
+
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
+	std::vector<Declaration const*>& declarations = m_inheritableDeclarations[&_base];
+	// The scope of the base also contains everything it imported from its own bases, which is skipped here.
 	for (auto const& nameAndDeclaration: iterator->second->declarations())
 		for (auto const& declaration: nameAndDeclaration.second)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
-				if (!m_currentScope->registerDeclaration(*declaration, false, false))
-				{
-					SourceLocation firstDeclarationLocation;
-					SourceLocation secondDeclarationLocation;
-					Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
-					solAssert(conflictingDeclaration, "");
-
-					// Usual shadowing is not an error
-					if (
-						dynamic_cast<ModifierDefinition const*>(declaration) &&
-						dynamic_cast<ModifierDefinition const*>(conflictingDeclaration)
-					)
-						continue;
-
-					// Public state variable can override functions
-					if (auto varDecl = dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
-						if (
-							dynamic_cast<FunctionDefinition const*>(declaration) &&
-							varDecl->isStateVariable() &&
-							varDecl->isPublic()
-						)
-							continue;
-
-					if (declaration->location().start < conflictingDeclaration->location().start)
-					{
-						firstDeclarationLocation = declaration->location();
-						secondDeclarationLocation = conflictingDeclaration->location();
-					}
-					else
-					{
-						firstDeclarationLocation = conflictingDeclaration->location();
-						secondDeclarationLocation = declaration->location();
-					}
+				declarations.emplace_back(declaration);
+	return declarations;
+}
 
-					m_errorReporter.declarationError(
-						9097_error,
-						secondDeclarationLocation,
-						SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
-						"Identifier already declared."
-					);
-				}
+void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
+{
+	for (Declaration const* declaration: inheritableDeclarations(_base))
+		if (!m_currentScope->registerDeclaration(*declaration, false, false))
+		{
+			SourceLocation firstDeclarationLocation;
+			SourceLocation secondDeclarationLocation;
+			Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
+			solAssert(conflictingDeclaration, "");
+
+			// Usual shadowing is not an error
+			if (
+				dynamic_cast<ModifierDefinition const*>(declaration) &&
+				dynamic_cast<ModifierDefinition const*>(conflictingDeclaration)
+			)
+				continue;
+
+			// Public state variable can override functions
+			if (auto varDecl = dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
+				if (
+					dynamic_cast<FunctionDefinition const*>(declaration) &&
+					varDecl->isStateVariable() &&
+					varDecl->isPublic()
+				)
+					continue;
+
+			if (declaration->location().start < conflictingDeclaration->location().start)
+			{
+				firstDeclarationLocation = declaration->location();
+				secondDeclarationLocation = conflictingDeclaration->location();
+			}
+			else
+			{
+				firstDeclarationLocation = conflictingDeclaration->location();
+				secondDeclarationLocation = declaration->location();
+			}
+
+			m_errorReporter.declarationError(
+				9097_error,
+				secondDeclarationLocation,
+				SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
+				"Identifier already declared."
+			);
+		}
 }
 
 void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
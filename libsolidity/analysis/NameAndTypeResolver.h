@@ -116,6 +116,9 @@ private:
 	/// Imports all members declared directly in the given contract (i.e. does not import inherited members)
 	/// into the current scope if they are not present already.
 	void importInheritedScope(ContractDefinition const& _base);
+	/// @returns the declarations of @a _base itself that are visible in derived contracts,
+	/// in the order of its scope. Cached, since bases are imported into every derived contract.
+	std::vector<Declaration const*> const& inheritableDeclarations(ContractDefinition const& _base);
 
 	/// Computes "C3-Linearization" of base contracts and stores it inside the contract. Reports errors if any
 	void linearizeBaseContracts(ContractDefinition& _contract);
@@ -129,6 +132,8 @@ private:
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	/// Cache for inheritableDeclarations().
+	std::map<ContractDefinition const*, std::vector<Declaration const*>> m_inheritableDeclarations;
 
 	langutil::EVMVersion m_evmVersion;
 	DeclarationContainer* m_currentScope = nullptr;
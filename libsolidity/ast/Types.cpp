@@ -44,6 +44,7 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
@@ -118,6 +119,33 @@ std::string toStringInParentheses(TypePointers const& _types, bool _withoutDataL
 	) + ')';
 }
 
+/// @returns true if _type is or contains a contract type in a position that the implicit
+/// conversion checks of arrays, tuples and functions recurse into. Conversions of contract types
+/// depend on the linearized base contracts, which are only filled in during analysis.
+bool containsContractType(Type const* _type)
+{
+	if (!_type)
+		return false;
+	switch (_type->category())
+	{
+	case Type::Category::Contract:
+		return true;
+	case Type::Category::Array:
+		return containsContractType(dynamic_cast<ArrayType const&>(*_type).baseType());
+	case Type::Category::Tuple:
+		return ranges::any_of(dynamic_cast<TupleType const&>(*_type).components(), containsContractType);
+	case Type::Category::Function:
+	{
+		auto const& functionType = dynamic_cast<FunctionType const&>(*_type);
+		return
+			ranges::any_of(functionType.parameterTypesIncludingSelf(), containsContractType) ||
+			ranges::any_of(functionType.returnParameterTypes(), containsContractType);
+	}
+	default:
+		return false;
+	}
+}
+
 }
 
 MemberList::Member::Member(Declaration const* _declaration, Type const* _type):
@@ -136,6 +164,24 @@ void Type::clearCache() const
 	m_members.clear();
 	m_stackItems.reset();
 	m_stackSize.reset();
+	m_implicitConversionCache.clear();
+}
+
+BoolResult Type::cachedImplicitConversion(Type const& _convertTo, std::function<BoolResult()> const& _compute) const
+{
+	if (containsContractType(this) || containsContractType(&_convertTo))
+		return _compute();
+
+	TypeProvider::RelationCacheStatistics& statistics = TypeProvider::relationCacheStatistics();
+	if (auto it = m_implicitConversionCache.find(&_convertTo); it != m_implicitConversionCache.end())
+	{
+		++statistics.hits;
+		return it->second;
+	}
+	++statistics.misses;
+	BoolResult result = _compute();
+	m_implicitConversionCache.emplace(&_convertTo, result);
+	return result;
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -1616,21 +1662,26 @@ BoolResult ArrayType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 	if (_convertTo.category() != category())
 		return false;
 	auto& convertTo = dynamic_cast<ArrayType const&>(_convertTo);
-	if (convertTo.isByteArray() != isByteArray() || convertTo.isString() != isString())
+	return cachedImplicitConversion(_convertTo, [&]() { return isImplicitlyConvertibleToUncached(convertTo); });
+}
+
+BoolResult ArrayType::isImplicitlyConvertibleToUncached(ArrayType const& _convertTo) const
+{
+	if (_convertTo.isByteArray() != isByteArray() || _convertTo.isString() != isString())
 		return false;
 	// memory/calldata to storage can be converted, but only to a direct storage reference
-	if (convertTo.location() == DataLocation::Storage && location() != DataLocation::Storage && convertTo.isPointer())
+	if (_convertTo.location() == DataLocation::Storage && location() != DataLocation::Storage && _convertTo.isPointer())
 		return false;
-	if (convertTo.location() == DataLocation::CallData && location() != convertTo.location())
+	if (_convertTo.location() == DataLocation::CallData && location() != _convertTo.location())
 		return false;
-	if (convertTo.location() == DataLocation::Storage && !convertTo.isPointer())
+	if (_convertTo.location() == DataLocation::Storage && !_convertTo.isPointer())
 	{
 		// Less restrictive conversion, since we need to copy anyway.
-		if (!baseType()->isImplicitlyConvertibleTo(*convertTo.baseType()))
+		if (!baseType()->isImplicitlyConvertibleTo(*_convertTo.baseType()))
 			return false;
-		if (convertTo.isDynamicallySized())
+		if (_convertTo.isDynamicallySized())
 			return true;
-		return !isDynamicallySized() && convertTo.length() >= length();
+		return !isDynamicallySized() && _convertTo.length() >= length();
 	}
 	else
 	{
@@ -1639,13 +1690,13 @@ BoolResult ArrayType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 		// This disallows assignment of nested dynamic arrays from storage to memory for now.
 		if (
 			*TypeProvider::withLocationIfReference(location(), baseType()) !=
-			*TypeProvider::withLocationIfReference(location(), convertTo.baseType())
+			*TypeProvider::withLocationIfReference(location(), _convertTo.baseType())
 		)
 			return false;
-		if (isDynamicallySized() != convertTo.isDynamicallySized())
+		if (isDynamicallySized() != _convertTo.isDynamicallySized())
 			return false;
 		// We also require that the size is the same.
-		if (!isDynamicallySized() && length() != convertTo.length())
+		if (!isDynamicallySized() && length() != _convertTo.length())
 			return false;
 		return true;
 	}
@@ -2695,23 +2746,26 @@ std::vector<std::tuple<std::string, Type const*>> UserDefinedValueType::makeStac
 BoolResult TupleType::isImplicitlyConvertibleTo(Type const& _other) const
 {
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
-	{
-		TypePointers const& targets = tupleType->components();
-		if (targets.empty())
-			return components().empty();
-		if (components().size() != targets.size())
-			return false;
-		for (size_t i = 0; i < targets.size(); ++i)
-			if (!components()[i] && targets[i])
-				return false;
-			else if (components()[i] && targets[i] && !components()[i]->isImplicitlyConvertibleTo(*targets[i]))
-				return false;
-		return true;
-	}
+		return cachedImplicitConversion(_other, [&]() { return isImplicitlyConvertibleToUncached(*tupleType); });
 	else
 		return false;
 }
 
+BoolResult TupleType::isImplicitlyConvertibleToUncached(TupleType const& _other) const
+{
+	TypePointers const& targets = _other.components();
+	if (targets.empty())
+		return components().empty();
+	if (components().size() != targets.size())
+		return false;
+	for (size_t i = 0; i < targets.size(); ++i)
+		if (!components()[i] && targets[i])
+			return false;
+		else if (components()[i] && targets[i] && !components()[i]->isImplicitlyConvertibleTo(*targets[i]))
+			return false;
+	return true;
+}
+
 std::string TupleType::richIdentifier() const
 {
 	return "t_tuple" + identifierList(components());
@@ -3119,33 +3173,37 @@ BoolResult FunctionType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 		return false;
 
 	FunctionType const& convertTo = dynamic_cast<FunctionType const&>(_convertTo);
+	return cachedImplicitConversion(_convertTo, [&]() { return isImplicitlyConvertibleToUncached(convertTo); });
+}
 
+BoolResult FunctionType::isImplicitlyConvertibleToUncached(FunctionType const& _convertTo) const
+{
 	// These two checks are duplicated in equalExcludingStateMutability, but are added here for error reporting.
-	if (convertTo.hasBoundFirstArgument() != hasBoundFirstArgument())
+	if (_convertTo.hasBoundFirstArgument() != hasBoundFirstArgument())
 		return BoolResult::err("Attached functions cannot be converted into unattached functions.");
 
-	if (convertTo.kind() != kind())
+	if (_convertTo.kind() != kind())
 		return BoolResult::err("Special functions cannot be converted to function types.");
 
 	if (
 		kind() == FunctionType::Kind::Declaration &&
-		m_declaration != convertTo.m_declaration
+		m_declaration != _convertTo.m_declaration
 	)
 		return BoolResult::err("Function declaration types referring to different functions cannot be converted to each other.");
 
-	if (!equalExcludingStateMutability(convertTo))
+	if (!equalExcludingStateMutability(_convertTo))
 		return false;
 
 	// non-payable should not be convertible to payable
-	if (m_stateMutability != StateMutability::Payable && convertTo.stateMutability() == StateMutability::Payable)
+	if (m_stateMutability != StateMutability::Payable && _convertTo.stateMutability() == StateMutability::Payable)
 		return false;
 
 	// payable should be convertible to non-payable, because you are free to pay 0 ether
-	if (m_stateMutability == StateMutability::Payable && convertTo.stateMutability() == StateMutability::NonPayable)
+	if (m_stateMutability == StateMutability::Payable && _convertTo.stateMutability() == StateMutability::NonPayable)
 		return true;
 
 	// e.g. pure should be convertible to view, but not the other way around.
-	if (m_stateMutability > convertTo.stateMutability())
+	if (m_stateMutability > _convertTo.stateMutability())
 		return false;
 
 	return true;
@@ -36,6 +36,7 @@
 
 #include <boost/rational.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -426,12 +427,20 @@ protected:
 	{
 		return {std::make_tuple(std::string(), nullptr)};
 	}
+	/// @returns the result of @a _compute for the implicit conversion of this type to @a _convertTo,
+	/// memoized per target type. Only used by types whose conversion checks are recursive or
+	/// allocate new types. Relies on types not changing after they have been provided.
+	/// Types containing contract types are not memoized, because their conversions depend on
+	/// the inheritance hierarchy, which is only known once analysis has resolved it.
+	BoolResult cachedImplicitConversion(Type const& _convertTo, std::function<BoolResult()> const& _compute) const;
 
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
 	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, Type const*>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+	/// Results of implicit conversion checks memoized by ``cachedImplicitConversion``.
+	mutable std::map<Type const*, BoolResult> m_implicitConversionCache;
 };
 
 /**
@@ -904,6 +913,7 @@ protected:
 private:
 	enum class ArrayKind { Ordinary, Bytes, String };
 
+	BoolResult isImplicitlyConvertibleToUncached(ArrayType const& _convertTo) const;
 	bigint unlimitedStaticCalldataSize(bool _padded) const;
 
 	///< Byte arrays ("bytes") and strings have different semantics from ordinary arrays.
@@ -1233,6 +1243,8 @@ protected:
 	}
 
 private:
+	BoolResult isImplicitlyConvertibleToUncached(TupleType const& _other) const;
+
 	std::vector<Type const*> const m_components;
 };
 
@@ -1525,6 +1537,7 @@ protected:
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 private:
 	static TypePointers parseElementaryTypeVector(strings const& _types);
+	BoolResult isImplicitlyConvertibleToUncached(FunctionType const& _convertTo) const;
 
 	TypePointers m_parameterTypes;
 	TypePointers m_returnParameterTypes;
@@ -261,7 +261,7 @@ private:
 
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
-	/// cases.
+	/// cases. The code of the function may be shared with other contracts.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
 	/// @returns the size of the static part of the encoding of the given types.
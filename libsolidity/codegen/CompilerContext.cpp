@@ -36,6 +36,7 @@
 #include <libyul/backends/evm/AsmCodeGen.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/Object.h>
 #include <libyul/YulString.h>
@@ -61,6 +62,86 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Replaces the debug data of all nodes of a Yul AST, including identifiers that are not
+/// expressions, by the given one.
+class DebugDataReplacer: public yul::ASTModifier
+{
+public:
+	explicit DebugDataReplacer(langutil::DebugData::ConstPtr _debugData): m_debugData(std::move(_debugData)) {}
+
+	using ASTModifier::operator();
+	void operator()(yul::Literal& _literal) override { _literal.debugData = m_debugData; }
+	void operator()(yul::Identifier& _identifier) override { _identifier.debugData = m_debugData; }
+	void operator()(yul::FunctionCall& _funCall) override
+	{
+		_funCall.debugData = m_debugData;
+		(*this)(_funCall.functionName);
+		ASTModifier::operator()(_funCall);
+	}
+	void operator()(yul::ExpressionStatement& _statement) override
+	{
+		_statement.debugData = m_debugData;
+		ASTModifier::operator()(_statement);
+	}
+	void operator()(yul::Assignment& _assignment) override
+	{
+		_assignment.debugData = m_debugData;
+		ASTModifier::operator()(_assignment);
+	}
+	void operator()(yul::VariableDeclaration& _varDecl) override
+	{
+		_varDecl.debugData = m_debugData;
+		replace(_varDecl.variables);
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(yul::If& _if) override
+	{
+		_if.debugData = m_debugData;
+		ASTModifier::operator()(_if);
+	}
+	void operator()(yul::Switch& _switch) override
+	{
+		_switch.debugData = m_debugData;
+		for (auto& _case: _switch.cases)
+			_case.debugData = m_debugData;
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(yul::FunctionDefinition& _fun) override
+	{
+		_fun.debugData = m_debugData;
+		replace(_fun.parameters);
+		replace(_fun.returnVariables);
+		ASTModifier::operator()(_fun);
+	}
+	void operator()(yul::ForLoop& _for) override
+	{
+		_for.debugData = m_debugData;
+		ASTModifier::operator()(_for);
+	}
+	void operator()(yul::Break& _break) override { _break.debugData = m_debugData; }
+	void operator()(yul::Continue& _continue) override { _continue.debugData = m_debugData; }
+	void operator()(yul::Leave& _leave) override { _leave.debugData = m_debugData; }
+	void operator()(yul::Block& _block) override
+	{
+		_block.debugData = m_debugData;
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	void replace(yul::TypedNameList& _names)
+	{
+		for (auto& name: _names)
+			name.debugData = m_debugData;
+	}
+
+	langutil::DebugData::ConstPtr m_debugData;
+};
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -433,6 +514,42 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	// Snippets are parsed, analyzed and optimized once and afterwards only moved to the current location.
+	// The optimiser is run in the same context each time, so its result only depends on the snippet and the settings.
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	InlineAssemblyCacheKey cacheKey{_assembly, _localVariables, std::nullopt};
+	if (optimize)
+		std::get<2>(cacheKey) = std::make_tuple(
+			_externallyUsedFunctions,
+			_optimiserSettings.optimizeStackAllocation,
+			_optimiserSettings.yulOptimiserSteps,
+			_optimiserSettings.yulOptimiserCleanupSteps,
+			_optimiserSettings.expectedExecutionsPerDeployment
+		);
+	if (!_system)
+		if (auto cached = m_inlineAssemblyCache.find(cacheKey); cached != m_inlineAssemblyCache.end())
+		{
+			++m_inlineAssemblyCacheHits;
+			CachedInlineAssembly& snippet = cached->second;
+			SourceLocation const& location = m_asm->currentSourceLocation();
+			if (snippet.debugData->nativeLocation != location)
+			{
+				snippet.debugData = langutil::DebugData::create(location, location);
+				DebugDataReplacer{snippet.debugData}(*snippet.code);
+			}
+			yul::CodeGenerator::assemble(
+				*snippet.code,
+				snippet.analysisInfo,
+				*m_asm,
+				m_evmVersion,
+				identifierAccess.generateCode,
+				_system,
+				_optimiserSettings.optimizeStackAllocation
+			);
+			updateSourceLocation();
+			return;
+		}
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	langutil::CharStream charStream(_assembly, _sourceName);
@@ -478,7 +595,7 @@ void CompilerContext::appendInlineAssembly(
 
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	if (optimize)
 	{
 		yul::Object obj;
 		obj.code = parserResult;
@@ -517,6 +634,12 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	if (!_system)
+		m_inlineAssemblyCache[std::move(cacheKey)] = CachedInlineAssembly{
+			parserResult,
+			analysisInfo,
+			langutil::DebugData::create(m_asm->currentSourceLocation(), m_asm->currentSourceLocation())
+		};
 	yul::CodeGenerator::assemble(
 		*parserResult,
 		analysisInfo,
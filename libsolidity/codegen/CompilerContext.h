@@ -43,8 +43,10 @@
 
 #include <functional>
 #include <ostream>
+#include <optional>
 #include <stack>
 #include <queue>
+#include <tuple>
 #include <utility>
 #include <limits>
 
@@ -63,13 +65,15 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<MultiUseYulFunctionCache> _yulFunctionCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_yulFunctionCollector(std::move(_yulFunctionCache)),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -277,6 +281,9 @@ public:
 	/// Otherwise returns "revert(0, 0)".
 	std::string revertReasonIfDebug(std::string const& _message = "");
 
+	/// @returns how often appendInlineAssembly() reused a snippet it had compiled before.
+	size_t inlineAssemblyCacheHits() const { return m_inlineAssemblyCacheHits; }
+
 	void optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSetting, std::set<yul::YulString> const& _externalIdentifiers = {});
 
 	/// Appends arbitrary data to the end of the bytecode.
@@ -385,6 +392,26 @@ private:
 	/// Generated Yul code used as utility. Source references from the bytecode can point here.
 	/// Produced from @a m_yulFunctionCollector.
 	std::string m_generatedYulUtilityCode;
+	/// Inline assembly snippet that was parsed and analyzed before, together with the debug data
+	/// all of its nodes currently carry.
+	struct CachedInlineAssembly
+	{
+		std::shared_ptr<yul::Block> code;
+		yul::AsmAnalysisInfo analysisInfo;
+		langutil::DebugData::ConstPtr debugData;
+	};
+	/// Everything an inline assembly snippet that is not system code is compiled from: its code, its
+	/// local variables and, if it is optimized, the externally used functions, whether to optimize
+	/// the stack allocation, the optimiser steps, the cleanup steps and the expected executions per deployment.
+	using InlineAssemblyCacheKey = std::tuple<
+		std::string,
+		std::vector<std::string>,
+		std::optional<std::tuple<std::set<std::string>, bool, std::string, std::string, size_t>>
+	>;
+	/// Inline assembly snippets, so that snippets that are generated repeatedly are parsed,
+	/// analyzed and optimized only once. System code is not stored here.
+	std::map<InlineAssemblyCacheKey, CachedInlineAssembly> m_inlineAssemblyCache;
+	size_t m_inlineAssemblyCacheHits = 0;
 	/// Container for ABI functions to be generated.
 	ABIFunctions m_abiFunctions;
 	/// Container for Yul Util functions to be generated.
@@ -30,6 +30,28 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+std::shared_ptr<MultiUseYulFunctionCache::Function const> MultiUseYulFunctionCache::find(
+	std::string const& _name,
+	Settings const& _settings
+) const
+{
+	std::lock_guard lock(m_mutex);
+	auto it = m_functions.find(Key{_name, _settings.evmVersion, _settings.revertStrings});
+	return it == m_functions.end() ? nullptr : it->second;
+}
+
+void MultiUseYulFunctionCache::insert(std::string const& _name, Settings const& _settings, Function _function)
+{
+	std::lock_guard lock(m_mutex);
+	for (std::string const& dependency: _function.dependencies)
+		if (!m_functions.count(Key{dependency, _settings.evmVersion, _settings.revertStrings}))
+			return;
+	m_functions.emplace(
+		Key{_name, _settings.evmVersion, _settings.revertStrings},
+		std::make_shared<Function const>(std::move(_function))
+	);
+}
+
 std::string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	std::string result = std::move(m_code);
@@ -40,13 +62,13 @@ std::string MultiUseYulFunctionCollector::requestedFunctions()
 
 std::string MultiUseYulFunctionCollector::createFunction(std::string const& _name, std::function<std::string()> const& _creator)
 {
+	// The code of functions that are not shared may depend on more than their name.
+	if (!m_pendingSharedFunctions.empty())
+		m_pendingSharedFunctions.back().cacheable = false;
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
-		std::string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name + "(") != std::string::npos, "Function not properly named.");
-		m_code += std::move(fun);
+		m_code += functionCode(_name, _creator);
 	}
 	return _name;
 }
@@ -57,24 +79,117 @@ std::string MultiUseYulFunctionCollector::createFunction(
 )
 {
 	solAssert(!_name.empty(), "");
+	if (!m_pendingSharedFunctions.empty())
+		m_pendingSharedFunctions.back().cacheable = false;
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
-		std::vector<std::string> arguments;
-		std::vector<std::string> returnParameters;
-		std::string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
-
-		m_code += Whiskers(R"(
-			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
-				<body>
-			}
-		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
+		m_code += functionCode(_name, _creator);
+	}
+	return _name;
+}
+
+std::string MultiUseYulFunctionCollector::createSharedFunction(
+	std::string const& _name,
+	MultiUseYulFunctionCache::Settings const& _settings,
+	std::function<std::string()> const& _creator
+)
+{
+	return addSharedFunction(_name, _settings, [&]() { return functionCode(_name, _creator); });
+}
+
+std::string MultiUseYulFunctionCollector::createSharedFunction(
+	std::string const& _name,
+	MultiUseYulFunctionCache::Settings const& _settings,
+	std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+)
+{
+	solAssert(!_name.empty(), "");
+	return addSharedFunction(_name, _settings, [&]() { return functionCode(_name, _creator); });
+}
+
+std::string MultiUseYulFunctionCollector::functionCode(std::string const& _name, std::function<std::string()> const& _creator)
+{
+	std::string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != std::string::npos, "Function not properly named.");
+	return fun;
+}
+
+std::string MultiUseYulFunctionCollector::functionCode(
+	std::string const& _name,
+	std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+)
+{
+	std::vector<std::string> arguments;
+	std::vector<std::string> returnParameters;
+	std::string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
+
+	return Whiskers(R"(
+		function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
+			<body>
+		}
+	)")
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
+}
+
+std::string MultiUseYulFunctionCollector::addSharedFunction(
+	std::string const& _name,
+	MultiUseYulFunctionCache::Settings const& _settings,
+	std::function<std::string()> const& _generateCode
+)
+{
+	if (!m_pendingSharedFunctions.empty())
+		m_pendingSharedFunctions.back().dependencies.push_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+	m_requestedFunctions.insert(_name);
+
+	if (m_cache)
+		if (auto cached = m_cache->find(_name, _settings))
+		{
+			addCachedFunction(*cached, _settings);
+			return _name;
+		}
+
+	m_pendingSharedFunctions.emplace_back();
+	std::string code;
+	try
+	{
+		code = _generateCode();
+	}
+	catch (...)
+	{
+		m_pendingSharedFunctions.pop_back();
+		throw;
 	}
+	PendingFunction generated = std::move(m_pendingSharedFunctions.back());
+	m_pendingSharedFunctions.pop_back();
+
+	if (m_cache && generated.cacheable)
+		m_cache->insert(_name, _settings, {code, std::move(generated.dependencies)});
+	m_code += std::move(code);
 	return _name;
 }
+
+void MultiUseYulFunctionCollector::addCachedFunction(
+	MultiUseYulFunctionCache::Function const& _function,
+	MultiUseYulFunctionCache::Settings const& _settings
+)
+{
+	// Replays the requests the generator of the function made.
+	for (std::string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			m_requestedFunctions.insert(dependency);
+			auto cachedDependency = m_cache->find(dependency, _settings);
+			solAssert(cachedDependency, "Dependency of cached Yul function not cached.");
+			addCachedFunction(*cachedDependency, _settings);
+		}
+	m_code += _function.code;
+}
@@ -22,14 +22,55 @@
 
 #pragma once
 
+#include <libsolidity/interface/DebugSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <set>
+#include <tuple>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Compilation-wide store of Yul functions whose code only depends on their name and on the
+ * code generation settings below, so that function collectors of different contracts can
+ * reuse them instead of generating them again.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Settings
+	{
+		langutil::EVMVersion evmVersion;
+		RevertStrings revertStrings;
+	};
+
+	struct Function
+	{
+		std::string code;
+		/// Names of the shared functions requested while generating the code, in order.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function cached under the given name and settings or nullptr.
+	std::shared_ptr<Function const> find(std::string const& _name, Settings const& _settings) const;
+	/// Stores a function unless one of its dependencies is not stored.
+	void insert(std::string const& _name, Settings const& _settings, Function _function);
+
+private:
+	using Key = std::tuple<std::string, langutil::EVMVersion, RevertStrings>;
+
+	mutable std::mutex m_mutex;
+	std::map<Key, std::shared_ptr<Function const>> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,6 +78,10 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<MultiUseYulFunctionCache> _cache = nullptr):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -47,6 +92,22 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Variants of createFunction for functions whose code only depends on @a _name and
+	/// @a _settings. If a cache is set, the code is taken from it if another collector already
+	/// generated it, together with the functions it requires.
+	std::string createSharedFunction(
+		std::string const& _name,
+		MultiUseYulFunctionCache::Settings const& _settings,
+		std::function<std::string()> const& _creator
+	);
+	std::string createSharedFunction(
+		std::string const& _name,
+		MultiUseYulFunctionCache::Settings const& _settings,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
+	std::shared_ptr<MultiUseYulFunctionCache> const& cache() const { return m_cache; }
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -57,8 +118,32 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// A shared function that is currently being generated.
+	struct PendingFunction
+	{
+		std::vector<std::string> dependencies;
+		/// False if the code requested a function that is not shared.
+		bool cacheable = true;
+	};
+
+	static std::string functionCode(std::string const& _name, std::function<std::string()> const& _creator);
+	static std::string functionCode(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
+	std::string addSharedFunction(
+		std::string const& _name,
+		MultiUseYulFunctionCache::Settings const& _settings,
+		std::function<std::string()> const& _generateCode
+	);
+	/// Adds the code of a cached function after those of its dependencies that were not added yet.
+	void addCachedFunction(MultiUseYulFunctionCache::Function const& _function, MultiUseYulFunctionCache::Settings const& _settings);
+
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	std::shared_ptr<MultiUseYulFunctionCache> m_cache;
+	std::vector<PendingFunction> m_pendingSharedFunctions;
 };
 
 }
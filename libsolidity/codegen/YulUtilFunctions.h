@@ -603,6 +603,15 @@ private:
 	/// signature: (array, index)
 	std::string longByteArrayStorageIndexAccessNoCheckFunction();
 
+	/// Creates a function through the function collector. The code of the functions created
+	/// here only depends on their name, the EVM version and the revert strings setting,
+	/// so it can be shared between contracts.
+	template<typename Creator>
+	std::string createFunction(std::string const& _name, Creator const& _creator)
+	{
+		return m_functionCollector.createSharedFunction(_name, {m_evmVersion, m_revertStrings}, _creator);
+	}
+
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings m_revertStrings;
 	MultiUseYulFunctionCollector& m_functionCollector;
@@ -56,7 +56,7 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
@@ -20,6 +20,7 @@
 
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTPortfolio.h>
 
 #include <liblangutil/CharStream.h>
@@ -47,10 +48,18 @@ BMC::BMC(
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _charStreamProvider),
 	m_interface(std::make_unique<smtutil::SMTPortfolio>(
-		_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout, _settings.printQuery
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_settings.timeout,
+		_settings.printQuery,
+		_settings.crossCheckSolvers,
+		_settings.smtlib2Solver.has_value()
 	))
 {
 	solAssert(!_settings.printQuery || _settings.solvers == smtutil::SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
+	if (_settings.cacheDirectory)
+		m_interface->setQueryCache(std::make_shared<smtutil::QueryCache>(*_settings.cacheDirectory));
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -33,6 +33,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
+#include <libsmtutil/QueryCache.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/StringUtils.h>
@@ -48,7 +49,9 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
 #include <charconv>
+#include <future>
 #include <queue>
 
 using namespace solidity;
@@ -1269,6 +1272,9 @@ void CHC::resetSourceAnalysis()
 		m_context.setSolver(smtlib2Interface->smtlib2Interface());
 	}
 
+	if (m_settings.cacheDirectory)
+		m_interface->setQueryCache(std::make_shared<QueryCache>(*m_settings.cacheDirectory));
+
 	m_context.reset();
 	m_context.resetUniqueId();
 	m_context.setAssertionAccumulation(false);
@@ -1876,11 +1882,11 @@ void CHC::addRule(smtutil::Expression const& _rule, std::string const& _ruleName
 	m_interface->addRule(_rule, _ruleName);
 }
 
-std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(
+	smtutil::Expression const& _query,
+	bool _counterexample
+)
 {
-	CheckResult result;
-	smtutil::Expression invariant(true);
-	CHCSolverInterface::CexGraph cex;
 	if (m_settings.printQuery)
 	{
 		auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
@@ -1891,46 +1897,41 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 			"CHC: Requested query:\n" + smtLibCode
 		);
 	}
-	std::tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	return solve(*m_interface, _query, _counterexample);
+}
+
+std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::solve(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query,
+	bool _counterexample
+) const
+{
+	CheckResult result;
+	smtutil::Expression invariant(true);
+	CHCSolverInterface::CexGraph cex;
+	std::tie(result, invariant, cex) = _solver.query(_query);
 	// We still need the ifdef because of Z3CHCInterface.
-		if (m_settings.solvers.z3)
-		{
+	if (result == CheckResult::SATISFIABLE && _counterexample && m_settings.solvers.z3)
+	{
 #ifdef HAVE_Z3
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			std::tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		std::tie(resultNoOpt, invariantNoOpt, cexNoOpt) = _solver.query(_query);
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = std::move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = std::move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
+		spacer->setSpacerOptions(true);
 #else
-			solAssert(false);
+		solAssert(false);
 #endif
-		}
-		break;
-	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
-		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
-		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
 	}
 	return {result, invariant, cex};
 }
@@ -2033,14 +2034,20 @@ void CHC::checkVerificationTargets()
 	}
 
 	std::set<unsigned> checkedErrorIds;
-	for (auto const& [targetId, placeholders]: targetEntryPoints)
-	{
-		auto const& target = m_verificationTargets.at(targetId);
-		auto [errorType, errorReporterId] = targetDescription(target);
+	if (m_settings.batchTargets)
+		checkAndReportTargetBatch(targetEntryPoints | ranges::views::keys | ranges::to<std::vector<unsigned>>(), targetEntryPoints);
+	else if (m_settings.threads > 1 && m_settings.solvers.z3)
+		checkAndReportTargetsConcurrently(targetEntryPoints);
+	else
+		for (auto const& [targetId, placeholders]: targetEntryPoints)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			auto [errorType, errorReporterId] = targetDescription(target);
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
-		checkedErrorIds.insert(target.errorId);
-	}
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		}
+	for (unsigned targetId: targetEntryPoints | ranges::views::keys)
+		checkedErrorIds.insert(m_verificationTargets.at(targetId).errorId);
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -2159,15 +2166,150 @@ void CHC::checkAndReportTarget(
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
+	encodeTargetQuery(_target, _placeholders);
+	reportTarget(_target, _errorReporterId, _satMsg, _unknownMsg, query(error()));
+}
+
+void CHC::checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints)
+{
+	// Every copy of the solver must contain the queries of all targets,
+	// so they are all encoded before the solver is copied.
+	std::vector<std::pair<CHCVerificationTarget const*, Predicate const*>> targets;
+	std::vector<smtutil::Expression> queries;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+	{
+		auto const& target = m_verificationTargets.at(targetId);
+		encodeTargetQuery(target, placeholders);
+		targets.emplace_back(&target, m_errorPredicate);
+		queries.push_back(error());
+	}
+
+	std::vector<std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> answers(
+		queries.size(),
+		{CheckResult::ERROR, smtutil::Expression(true), {}}
+	);
+	// We still need the ifdef because of Z3CHCInterface.
+#ifdef HAVE_Z3
+	auto const* z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	solAssert(z3Interface);
+	size_t threads = std::min<size_t>(m_settings.threads, queries.size());
+	// Z3 contexts are not thread-safe, so every thread queries its own copy.
+	std::vector<std::unique_ptr<Z3CHCInterface>> solvers;
+	for (size_t i = 0; i < threads; ++i)
+		solvers.push_back(z3Interface->copy());
+
+	{
+		std::vector<std::future<void>> workers;
+		for (size_t i = 0; i < threads; ++i)
+			workers.emplace_back(std::async([&, i]() {
+				for (size_t j = i; j < queries.size(); j += threads)
+					answers[j] = solve(*solvers[i], queries[j]);
+			}));
+		for (auto& worker: workers)
+			worker.get();
+	}
+#else
+	solAssert(false);
+#endif
+
+	for (size_t i = 0; i < targets.size(); ++i)
+	{
+		auto const& [target, errorPredicate] = targets[i];
+		if (m_unsafeTargets.count(target->errorNode) && m_unsafeTargets.at(target->errorNode).count(target->type))
+			continue;
+
+		m_errorPredicate = errorPredicate;
+		auto [errorType, errorReporterId] = targetDescription(*target);
+		reportTarget(*target, errorReporterId, errorType + " happens here.", errorType + " might happen here.", answers[i]);
+	}
+}
+
+void CHC::checkAndReportTargetBatch(
+	std::vector<unsigned> const& _targetIds,
+	std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints
+)
+{
+	std::vector<unsigned> targetIds;
+	for (unsigned targetId: _targetIds)
+	{
+		auto const& target = m_verificationTargets.at(targetId);
+		if (!m_unsafeTargets.count(target.errorNode) || !m_unsafeTargets.at(target.errorNode).count(target.type))
+			targetIds.push_back(targetId);
+	}
+	if (targetIds.empty())
+		return;
+
+	if (targetIds.size() == 1)
+	{
+		auto const& target = m_verificationTargets.at(targetIds.front());
+		auto [errorType, errorReporterId] = targetDescription(target);
+		checkAndReportTarget(target, _targetEntryPoints.at(targetIds.front()), errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		return;
+	}
+
+	// The error block is reachable if and only if one of the targets is.
 	createErrorBlock();
+	for (unsigned targetId: targetIds)
+		connectTargetToError(m_verificationTargets.at(targetId), _targetEntryPoints.at(targetId));
+	auto answer = query(error(), false);
+	if (std::get<0>(answer) == CheckResult::UNSATISFIABLE)
+	{
+		// A single invariant proves all targets safe.
+		for (unsigned targetId: targetIds)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			auto [errorType, errorReporterId] = targetDescription(target);
+			reportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.", answer);
+		}
+		return;
+	}
+
+	if (std::get<0>(answer) == CheckResult::SATISFIABLE)
+	{
+		// At least one target is reachable.
+		auto middle = targetIds.begin() + static_cast<std::ptrdiff_t>(targetIds.size() / 2);
+		checkAndReportTargetBatch(std::vector<unsigned>(targetIds.begin(), middle), _targetEntryPoints);
+		checkAndReportTargetBatch(std::vector<unsigned>(middle, targetIds.end()), _targetEntryPoints);
+		return;
+	}
+
+	// The query was too hard or the solvers failed. Smaller batches would most likely
+	// fail the same way and multiply the time spent, so every target is checked on its own.
+	for (unsigned targetId: targetIds)
+		checkAndReportTargetBatch({targetId}, _targetEntryPoints);
+}
+
+void CHC::encodeTargetQuery(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders)
+{
+	createErrorBlock();
+	connectTargetToError(_target, _placeholders);
+}
+
+void CHC::connectTargetToError(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders)
+{
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
 			placeholder.fromPredicate,
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	std::string const& _satMsg,
+	std::string const& _unknownMsg,
+	std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _answer
+)
+{
+	auto const& [result, invariant, model] = _answer;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	if (result == CheckResult::CONFLICTING)
+		m_errorReporter.warning(1988_error, location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+	else if (result == CheckResult::ERROR)
+		m_errorReporter.warning(1218_error, location, "CHC: Error trying to invoke SMT solver.");
+
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
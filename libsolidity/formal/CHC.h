@@ -285,7 +285,18 @@ private:
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
-	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// If _counterexample is false, the model is not made complete.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::Expression const& _query,
+		bool _counterexample = true
+	);
+	/// Solves _query with _solver without reporting anything.
+	/// Can be called concurrently for different solvers.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> solve(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query,
+		bool _counterexample = true
+	) const;
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -299,6 +310,29 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Solves the queries of all targets on m_settings.threads copies of the Horn solver
+	/// and reports the results in the same order as checkAndReportTarget would.
+	void checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints);
+	/// Checks whether any of the targets with the given ids is reachable with a single query.
+	/// If none is, they are all safe. If one is, the targets are split in two halves,
+	/// which are checked in the same way, until single targets are checked with checkAndReportTarget.
+	/// If the answer is unknown, every target is checked on its own.
+	void checkAndReportTargetBatch(
+		std::vector<unsigned> const& _targetIds,
+		std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints
+	);
+	/// Creates the error block of _target and connects it to the given placeholders.
+	void encodeTargetQuery(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Connects the given placeholders of _target to the current error block.
+	void connectTargetToError(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Reports the answer of the solver to the query of _target, whose error block is m_errorPredicate.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _answer
+	);
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
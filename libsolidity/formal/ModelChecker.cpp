@@ -121,6 +121,14 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.none())
 		return;
 
+	if (m_settings.engine.chc && m_settings.batchTargets && m_settings.threads > 1)
+		m_uniqueErrorReporter.warning(
+			6412_error,
+			SourceLocation(),
+			"CHC: Checking the verification targets in batches takes precedence over checking them on several threads. "
+			"The number of threads is ignored."
+		);
+
 	if (m_settings.engine.chc)
 		m_chc.analyze(_source);
 
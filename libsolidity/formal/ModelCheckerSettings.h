@@ -20,8 +20,11 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem.hpp>
+
 #include <optional>
 #include <set>
+#include <string>
 
 namespace solidity::frontend
 {
@@ -157,8 +160,16 @@ struct ModelCheckerExtCalls
 
 struct ModelCheckerSettings
 {
+	/// If true, CHC first checks whether any of the targets is reachable with a single query
+	/// and only narrows the targets down if one is.
+	bool batchTargets = false;
 	std::optional<unsigned> bmcLoopIterations;
+	/// Directory in which the answers of the solvers are cached across runs.
+	std::optional<boost::filesystem::path> cacheDirectory;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
+	/// If true, BMC waits for the answers of all enabled solvers and reports conflicting answers.
+	/// Otherwise the first solver to answer a query decides the result.
+	bool crossCheckSolvers = false;
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
 	/// where k and m are slack variables.
@@ -173,16 +184,24 @@ struct ModelCheckerSettings
 	bool showProvedSafe = false;
 	bool showUnproved = false;
 	bool showUnsupported = false;
+	/// Command line of an interactive SMT-LIB2 solver that BMC keeps running
+	/// and sends its queries to incrementally.
+	std::optional<std::string> smtlib2Solver;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
+	/// Number of threads CHC uses to solve the queries of the verification targets.
+	unsigned threads = 1;
 	std::optional<unsigned> timeout; // in milliseconds
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			batchTargets == _other.batchTargets &&
 			bmcLoopIterations == _other.bmcLoopIterations &&
+			cacheDirectory == _other.cacheDirectory &&
 			contracts == _other.contracts &&
+			crossCheckSolvers == _other.crossCheckSolvers &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
@@ -191,8 +210,10 @@ struct ModelCheckerSettings
 			showProvedSafe == _other.showProvedSafe &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
+			smtlib2Solver == _other.smtlib2Solver &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
+			threads == _other.threads &&
 			timeout == _other.timeout;
 	}
 };
@@ -100,6 +100,10 @@
 #include <limits>
 #include <string>
 
+#ifdef PROFILE_TYPE_RELATIONS
+#include <iostream>
+#endif
+
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
@@ -109,23 +113,14 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+	m_typeProvider{std::make_unique<TypeProvider>()},
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 void CompilerStack::createAndAssignCallGraphs()
 {
@@ -316,6 +311,7 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, std::string const& _re
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	m_stackState = Empty;
 	m_sources.clear();
 	m_maxAstId.reset();
@@ -341,7 +337,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	m_typeProvider->clear();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -357,6 +353,7 @@ void CompilerStack::setSources(StringMap _sources)
 
 bool CompilerStack::parse()
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
@@ -372,6 +369,7 @@ bool CompilerStack::parse()
 
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
+		checkCancelled();
 		std::string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
 		source.ast = parser.parse(*source.charStream);
@@ -428,6 +426,7 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(std::map<std::string, Json::Value> const& _sources)
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(_sources);
@@ -452,12 +451,15 @@ void CompilerStack::importASTs(std::map<std::string, Json::Value> const& _source
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState != ParsedAndImported)
 		solThrow(CompilerError, "Must call analyze only after parsing was successful.");
 
 	if (!resolveImports())
 		return false;
 
+	checkCancelled();
+
 	for (Source const* source: m_sourceOrder)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
@@ -473,6 +475,7 @@ bool CompilerStack::analyze()
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
+		checkCancelled();
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
@@ -488,6 +491,7 @@ bool CompilerStack::analyze()
 				return false;
 
 		resolver.warnHomonymDeclarations();
+		checkCancelled();
 
 		{
 			DocStringTagParser docStringTagParser(m_errorReporter);
@@ -500,6 +504,7 @@ bool CompilerStack::analyze()
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
+		checkCancelled();
 
 		if (experimentalSolidity)
 		{
@@ -516,6 +521,17 @@ bool CompilerStack::analyze()
 		noErrors = false;
 	}
 
+#ifdef PROFILE_TYPE_RELATIONS
+	TypeProvider::RelationCacheStatistics const& statistics = TypeProvider::relationCacheStatistics();
+	size_t lookups = statistics.hits + statistics.misses;
+	std::cerr << fmt::format(
+		"Type relation cache: {} lookups, {} hits ({:.1f}%)",
+		lookups,
+		statistics.hits,
+		lookups ? 100.0 * static_cast<double>(statistics.hits) / static_cast<double>(lookups) : 0.0
+	) << std::endl;
+#endif
+
 	if (!noErrors)
 		return false;
 
@@ -533,6 +549,8 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 		if (source->ast && !declarationTypeChecker.check(*source->ast))
 			return false;
 
+	checkCancelled();
+
 	// Requires DeclarationTypeChecker to have run
 	DocStringTagParser docStringTagParser(m_errorReporter);
 	for (Source const* source: m_sourceOrder)
@@ -556,10 +574,12 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	//
 	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 	// which is only done one step later.
+	checkCancelled();
 	TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 	for (Source const* source: m_sourceOrder)
 		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 			noErrors = false;
+	checkCancelled();
 
 	if (noErrors)
 	{
@@ -603,6 +623,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
 
+	checkCancelled();
 	if (noErrors)
 	{
 		// Control flow graph generator and analyzer. It can check for issues such as
@@ -623,6 +644,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 		}
 	}
 
+	checkCancelled();
 	if (noErrors)
 	{
 		// Checks for common mistakes. Only generates warnings.
@@ -644,6 +666,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 			noErrors = false;
 	}
 
+	checkCancelled();
 	if (noErrors)
 	{
 		// Run SMTChecker
@@ -658,8 +681,12 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 		{
 			m_modelCheckerSettings.solvers = ModelChecker::checkRequestedSolvers(m_modelCheckerSettings.solvers, m_errorReporter);
 			if (auto* universalCallback = m_readFile.target<frontend::UniversalCallback>())
+			{
 				if (m_modelCheckerSettings.solvers.eld)
 					universalCallback->smtCommand().setEldarica(m_modelCheckerSettings.timeout);
+				if (m_modelCheckerSettings.solvers.smtlib2 && m_modelCheckerSettings.smtlib2Solver)
+					universalCallback->smtCommand().setSessionSolver(*m_modelCheckerSettings.smtlib2Solver);
+			}
 		}
 
 		ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
@@ -673,6 +700,12 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	return noErrors;
 }
 
+void CompilerStack::checkCancelled() const
+{
+	if (m_isCancelled && m_isCancelled())
+		BOOST_THROW_EXCEPTION(CompilationCancelled());
+}
+
 bool CompilerStack::analyzeExperimental()
 {
 	solAssert(!m_experimentalAnalysis);
@@ -724,6 +757,7 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
@@ -735,6 +769,9 @@ bool CompilerStack::compile(State _stopAfter)
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
+	m_yulFunctionCache = std::make_shared<MultiUseYulFunctionCache>();
+	ScopeGuard releaseYulFunctionCache([&]() { m_yulFunctionCache.reset(); });
+
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
@@ -1045,6 +1082,7 @@ Json::Value const& CompilerStack::contractABI(std::string const& _contractName)
 
 Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1064,6 +1102,7 @@ Json::Value const& CompilerStack::storageLayout(std::string const& _contractName
 
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1083,6 +1122,7 @@ Json::Value const& CompilerStack::natspecUser(std::string const& _contractName)
 
 Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1102,6 +1142,7 @@ Json::Value const& CompilerStack::natspecDev(std::string const& _contractName) c
 
 Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1114,6 +1155,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json::Value CompilerStack::interfaceSymbols(std::string const& _contractName) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1146,6 +1188,7 @@ Json::Value CompilerStack::interfaceSymbols(std::string const& _contractName) co
 
 bytes CompilerStack::cborMetadata(std::string const& _contractName, bool _forIR) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1154,6 +1197,7 @@ bytes CompilerStack::cborMetadata(std::string const& _contractName, bool _forIR)
 
 std::string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState < AnalysisSuccessful)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1480,7 +1524,12 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		m_yulFunctionCache
+	);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1547,7 +1596,8 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 			sourceIndices(),
 			m_debugInfoSelection,
 			this,
-			m_optimiserSettings
+			m_optimiserSettings,
+			m_yulFunctionCache
 		);
 		compiledContract.yulIR = generator.run(
 			_contract,
@@ -1713,6 +1763,9 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
+		// Only included if set, so that the metadata of existing settings does not change.
+		if (m_optimiserSettings.runCSEAcrossBlocks)
+			details["cseAcrossBlocks"] = true;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["simpleCounterForLoopUncheckedIncrement"] = m_optimiserSettings.simpleCounterForLoopUncheckedIncrement;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
@@ -1720,6 +1773,8 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.splitLargeSwitches)
+				details["yulDetails"]["splitLargeSwitches"] = true;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps;
 		}
 		else if (
@@ -1912,6 +1967,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json::Value CompilerStack::gasEstimates(std::string const& _contractName) const
 {
+	TypeProvider::Activation typeProviderActivation(*m_typeProvider);
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
@@ -77,16 +77,21 @@ namespace solidity::frontend
 class ASTNode;
 class ContractDefinition;
 class FunctionDefinition;
+class MultiUseYulFunctionCache;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 namespace experimental
 {
 class Analysis;
 }
 
+/// Thrown by the compiler stack if the compilation was aborted by its cancellation check.
+struct CompilationCancelled: virtual util::Exception {};
+
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
  * It holds state and can be used to either step through the compilation stages (and abort e.g.
@@ -137,6 +142,11 @@ public:
 	/// @returns the list of errors that occurred during parsing and type checking.
 	langutil::ErrorList const& errors() const { return m_errorReporter.errors(); }
 
+	/// @returns the provider of the types of this compilation. The functions of the compiler stack
+	/// activate it while they run. Code using the types of the compilation outside of them has to
+	/// activate it as well, see TypeProvider::Activation.
+	TypeProvider& typeProvider() const { return *m_typeProvider; }
+
 	/// @returns the current state.
 	State state() const { return m_stackState; }
 
@@ -190,6 +200,11 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Sets a function that is queried between the passes of parsing and analysis. As soon as it
+	/// returns true, the compilation is aborted by throwing CompilationCancelled, which leaves the
+	/// compiler stack in an unusable state.
+	void setCancellationCheck(std::function<bool()> _isCancelled) { m_isCancelled = std::move(_isCancelled); }
+
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
@@ -413,6 +428,9 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	bool resolveImports();
 
+	/// Throws CompilationCancelled if the cancellation check says so.
+	void checkCancelled() const;
+
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
 
@@ -504,7 +522,10 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// Declared first, so that the types outlive everything referring to them.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	ReadCallback::Callback m_readFile;
+	std::function<bool()> m_isCancelled;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
@@ -524,6 +545,8 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Yul utility functions generated for one contract and reused for the others during compile().
+	std::shared_ptr<MultiUseYulFunctionCache> m_yulFunctionCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -118,9 +118,11 @@ struct OptimiserSettings
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
+			runCSEAcrossBlocks == _other.runCSEAcrossBlocks &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			simpleCounterForLoopUncheckedIncrement == _other.simpleCounterForLoopUncheckedIncrement &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			splitLargeSwitches == _other.splitLargeSwitches &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
@@ -144,6 +146,9 @@ struct OptimiserSettings
 	bool runDeduplicate = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
+	/// Let the common subexpression eliminator propagate its knowledge across basic blocks
+	/// whose predecessors are all statically known. Only has an effect if @a runCSE is set.
+	bool runCSEAcrossBlocks = false;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
@@ -151,6 +156,9 @@ struct OptimiserSettings
 	bool simpleCounterForLoopUncheckedIncrement = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool optimizeStackAllocation = false;
+	/// Lower large switch statements to a binary search over their case values during code
+	/// generation from Yul to bytecode, if beneficial for the expected number of executions.
+	bool splitLargeSwitches = false;
 	/// Allow unchecked arithmetic when incrementing the counter of certain kinds of 'for' loop
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
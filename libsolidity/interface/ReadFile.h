@@ -43,7 +43,9 @@ public:
 	enum class Kind
 	{
 		ReadFile,
-		SMTQuery
+		SMTQuery,
+		/// Incremental SMT-LIB2 commands for a solver that keeps its state between calls.
+		SMTSession
 	};
 
 	static std::string kindString(Kind _kind)
@@ -54,6 +56,8 @@ public:
 			return "source";
 		case Kind::SMTQuery:
 			return "smt-query";
+		case Kind::SMTSession:
+			return "smt-session";
 		default:
 			solAssert(false, "");
 		}
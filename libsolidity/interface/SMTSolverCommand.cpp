@@ -24,12 +24,21 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/TemporaryDirectory.h>
 
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/process.hpp>
 
+#include <algorithm>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <pthread.h>
+#endif
+
 using solidity::langutil::InternalCompilerError;
 using solidity::util::errinfo_comment;
 
@@ -37,6 +46,82 @@ using solidity::util::errinfo_comment;
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Echoed after the commands of a session, to recognize the end of the output of the solver.
+std::string const sessionEndMarker = "solc-smt-session-end";
+
+/// Blocks SIGPIPE in the current thread while it exists, so that writing to a solver
+/// that stopped fails instead of terminating the compiler.
+/// A SIGPIPE raised in the meantime is discarded.
+class SigpipeBlocker
+{
+public:
+#if defined(_WIN32)
+	SigpipeBlocker() = default;
+#else
+	SigpipeBlocker()
+	{
+		sigemptyset(&m_sigpipe);
+		sigaddset(&m_sigpipe, SIGPIPE);
+		sigset_t pending;
+		sigpending(&pending);
+		m_alreadyPending = sigismember(&pending, SIGPIPE) == 1;
+		pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_previousMask);
+	}
+
+	~SigpipeBlocker()
+	{
+		sigset_t pending;
+		sigpending(&pending);
+		if (!m_alreadyPending && sigismember(&pending, SIGPIPE) == 1)
+		{
+			int signalNumber;
+			sigwait(&m_sigpipe, &signalNumber);
+		}
+		pthread_sigmask(SIG_SETMASK, &m_previousMask, nullptr);
+	}
+
+private:
+	sigset_t m_sigpipe;
+	sigset_t m_previousMask;
+	bool m_alreadyPending = false;
+#endif
+};
+
+}
+
+/// Running interactive solver, connected through its standard input and output.
+struct SMTSolverCommand::Session
+{
+	Session(boost::filesystem::path const& _binary, std::vector<std::string> const& _arguments):
+		process(
+			_binary,
+			_arguments,
+			boost::process::std_in < input,
+			boost::process::std_out > output,
+			boost::process::std_err > boost::process::null
+		)
+	{}
+
+	~Session()
+	{
+		std::error_code error;
+		process.terminate(error);
+		// Closes the pipe without flushing the stream, which fails if the solver stopped.
+		input.pipe().close();
+	}
+
+	boost::process::opstream input;
+	boost::process::ipstream output;
+	boost::process::child process;
+};
+
+SMTSolverCommand::SMTSolverCommand() = default;
+
+SMTSolverCommand::~SMTSolverCommand() = default;
+
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds)
 {
 	m_arguments.clear();
@@ -49,6 +134,16 @@ void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMillisec
 	}
 }
 
+void SMTSolverCommand::setSessionSolver(std::string const& _commandLine)
+{
+	std::vector<std::string> words;
+	boost::split(words, _commandLine, boost::is_space(), boost::token_compress_on);
+	words.erase(std::remove(words.begin(), words.end(), ""), words.end());
+	m_session.reset();
+	m_sessionSolverCmd = words.empty() ? "" : words.front();
+	m_sessionArguments = words.empty() ? std::vector<std::string>{} : std::vector<std::string>(words.begin() + 1, words.end());
+}
+
 ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query)
 {
 	try
@@ -98,4 +193,61 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 	}
 }
 
+ReadCallback::Result SMTSolverCommand::continueSession(std::string const& _kind, std::string const& _commands)
+{
+	try
+	{
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTSession))
+			solAssert(false, "SMTSession callback used as callback kind " + _kind);
+
+		if (m_sessionSolverCmd.empty())
+			return ReadCallback::Result{false, "No session solver set."};
+
+		if (!m_session)
+		{
+			boost::filesystem::path solverBin = m_sessionSolverCmd;
+			if (!solverBin.has_parent_path())
+				solverBin = boost::process::search_path(m_sessionSolverCmd);
+			if (solverBin.empty())
+				return ReadCallback::Result{false, m_sessionSolverCmd + " binary not found."};
+			m_session = std::make_unique<Session>(solverBin, m_sessionArguments);
+		}
+
+		if (!m_session->process.running())
+		{
+			m_session.reset();
+			return ReadCallback::Result{false, m_sessionSolverCmd + " is not running."};
+		}
+
+		{
+			SigpipeBlocker sigpipeBlocker;
+			m_session->input << _commands << "(echo \"" << sessionEndMarker << "\")" << std::endl;
+		}
+		if (!m_session->input)
+		{
+			m_session.reset();
+			return ReadCallback::Result{false, m_sessionSolverCmd + " stopped unexpectedly."};
+		}
+
+		std::string response;
+		std::string line;
+		while (std::getline(m_session->output, line))
+		{
+			// Some solvers print the echoed string with quotes, others without.
+			if (line == sessionEndMarker || line == "\"" + sessionEndMarker + "\"")
+				return ReadCallback::Result{true, response};
+			if (!line.empty())
+				response += line + "\n";
+		}
+
+		m_session.reset();
+		return ReadCallback::Result{false, m_sessionSolverCmd + " stopped unexpectedly."};
+	}
+	catch (...)
+	{
+		m_session.reset();
+		return ReadCallback::Result{false, "Unknown exception in SMTSession callback: " + boost::current_exception_diagnostic_information()};
+	}
+}
+
 }
@@ -21,6 +21,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <memory>
+
 namespace solidity::frontend
 {
 
@@ -28,8 +30,15 @@ namespace solidity::frontend
 class SMTSolverCommand
 {
 public:
+	SMTSolverCommand();
+	~SMTSolverCommand();
+
 	/// Calls an SMT solver with the given query.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query);
+	/// Sends the given SMT-LIB2 commands to the solver of the session and returns its output.
+	/// The solver is started on first use and keeps running, together with its assertion stack,
+	/// until the session fails or this object is destroyed.
+	frontend::ReadCallback::Result continueSession(std::string const& _kind, std::string const& _commands);
 
 	frontend::ReadCallback::Callback solver()
 	{
@@ -37,11 +46,21 @@ public:
 	}
 
 	void setEldarica(std::optional<unsigned int> timeoutInMilliseconds);
+	/// Sets the command line of the interactive SMT-LIB2 solver used by continueSession,
+	/// for example "z3 -in".
+	void setSessionSolver(std::string const& _commandLine);
 
 private:
+	struct Session;
+
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+
+	/// The name and arguments of the interactive solver.
+	std::string m_sessionSolverCmd;
+	std::vector<std::string> m_sessionArguments;
+	std::unique_ptr<Session> m_session;
 };
 
 }
@@ -44,6 +44,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -430,7 +431,7 @@ std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"batchTargets", "bmcLoopIterations", "contracts", "crossCheckSolvers", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "threads", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -442,7 +443,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
+	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "cseAcrossBlocks", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -599,6 +600,8 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "cseAcrossBlocks", settings.runCSEAcrossBlocks))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
@@ -617,10 +620,12 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 				return {std::move(settings)};
 			}
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "splitLargeSwitches", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "splitLargeSwitches", settings.splitLargeSwitches))
+				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps, settings.yulOptimiserCleanupSteps, settings.runYulOptimiser))
 				return *error;
 		}
@@ -628,6 +633,156 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return {std::move(settings)};
 }
 
+/// @returns the output for an exception that escaped the compilation.
+/// Must only be called while handling that exception.
+Json::Value formatCurrentException()
+{
+	try
+	{
+		throw;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (util::Exception const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
+}
+
+void StandardCompiler::OutputWriter::set(Json::Value const& _output)
+{
+	if (!m_stream)
+	{
+		*m_output = _output;
+		return;
+	}
+	solAssert(!m_started);
+	start();
+	for (auto const& key: _output.getMemberNames())
+		member(key, _output[key]);
+}
+
+void StandardCompiler::OutputWriter::beginObject(std::string const& _key)
+{
+	bufferTail(_key);
+	if (m_output)
+	{
+		Json::Value& object = (*m_objects.back())[_key] = Json::objectValue;
+		m_objects.push_back(&object);
+		return;
+	}
+	if (m_bufferingTail)
+	{
+		m_tail.push_back({TailItem::Kind::BeginObject, _key, {}});
+		return;
+	}
+	start();
+	m_stream->beginObject(_key);
+}
+
+void StandardCompiler::OutputWriter::member(std::string const& _key, Json::Value _value)
+{
+	bufferTail(_key);
+	if (m_output)
+	{
+		(*m_objects.back())[_key] = std::move(_value);
+		return;
+	}
+	if (m_bufferingTail)
+	{
+		m_tail.push_back({TailItem::Kind::Member, _key, util::jsonPrint(_value, m_stream->format())});
+		return;
+	}
+	start();
+	m_stream->member(_key, _value);
+}
+
+void StandardCompiler::OutputWriter::endObject()
+{
+	if (m_output)
+		m_objects.pop_back();
+	else if (m_bufferingTail)
+		m_tail.push_back({TailItem::Kind::EndObject, {}, {}});
+	else
+		m_stream->endObject();
+}
+
+void StandardCompiler::OutputWriter::fail(Json::Value const& _fatalError)
+{
+	if (!m_stream)
+	{
+		*m_output = _fatalError;
+		m_objects = {m_output};
+		return;
+	}
+	m_bufferingTail = false;
+	m_tail.clear();
+	if (!m_started)
+	{
+		set(_fatalError);
+		return;
+	}
+	while (m_stream->depth() > 1)
+		m_stream->endObject();
+	member("errors", _fatalError["errors"]);
+}
+
+void StandardCompiler::OutputWriter::finish()
+{
+	if (!m_stream)
+		return;
+	start();
+	for (TailItem& item: m_tail)
+		switch (item.kind)
+		{
+		case TailItem::Kind::BeginObject:
+			m_stream->beginObject(item.key);
+			break;
+		case TailItem::Kind::Member:
+			m_stream->printedMember(item.key, std::move(item.printedValue));
+			break;
+		case TailItem::Kind::EndObject:
+			m_stream->endObject();
+			break;
+		}
+	m_tail.clear();
+	m_bufferingTail = false;
+	m_stream->endObject();
+}
+
+size_t StandardCompiler::OutputWriter::bufferedBytes() const
+{
+	size_t bytes = 0;
+	for (TailItem const& item: m_tail)
+		bytes += item.printedValue.size();
+	return bytes;
+}
+
+void StandardCompiler::OutputWriter::start()
+{
+	if (!m_started)
+		m_stream->beginObject();
+	m_started = true;
+}
+
+void StandardCompiler::OutputWriter::bufferTail(std::string const& _key)
+{
+	// Everything from the errors on is kept back, so that an exception can still replace it,
+	// while the contracts, which make up the bulk of the output, are streamed.
+	if (m_stream && !m_bufferingTail && m_stream->depth() <= 1 && _key >= "errors")
+		m_bufferingTail = true;
 }
 
 std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -1026,6 +1181,22 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.contracts = {std::move(sourceContracts)};
 	}
 
+	if (modelCheckerSettings.isMember("batchTargets"))
+	{
+		auto const& batchTargets = modelCheckerSettings["batchTargets"];
+		if (!batchTargets.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.batchTargets must be a Boolean.");
+		ret.modelCheckerSettings.batchTargets = batchTargets.asBool();
+	}
+
+	if (modelCheckerSettings.isMember("crossCheckSolvers"))
+	{
+		auto const& crossCheckSolvers = modelCheckerSettings["crossCheckSolvers"];
+		if (!crossCheckSolvers.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.crossCheckSolvers must be a Boolean.");
+		ret.modelCheckerSettings.crossCheckSolvers = crossCheckSolvers.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("divModNoSlacks"))
 	{
 		auto const& divModNoSlacks = modelCheckerSettings["divModNoSlacks"];
@@ -1160,6 +1331,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.targets = targets;
 	}
 
+	if (modelCheckerSettings.isMember("threads"))
+	{
+		auto const& threads = modelCheckerSettings["threads"];
+		if (!threads.isUInt() || threads.asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.threads must be a positive integer.");
+		ret.modelCheckerSettings.threads = threads.asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("timeout"))
 	{
 		if (!modelCheckerSettings["timeout"].isUInt())
@@ -1290,7 +1469,7 @@ Json::Value StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSetti
 	return util::removeNullMembers(output);
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputWriter& _output)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
@@ -1466,20 +1645,139 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		(compilationFailed || analysisFailed || !parsingSuccess) &&
 		errors.empty()
 	)
-		return formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	{
+		_output.set(formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed."));
+		return;
+	}
 
+	// The members of the output are passed in the order of their keys, so that each contract
+	// can be written out as soon as its artifacts have been collected.
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value auxiliaryInputRequested = Json::objectValue;
 		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInputRequested["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.member("auxiliaryInputRequested", std::move(auxiliaryInputRequested));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
+	std::map<std::string, std::set<std::string>> contractNamesBySource;
+	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != std::string::npos, "");
+		contractNamesBySource[contractName.substr(0, colon)].insert(contractName.substr(colon + 1));
+	}
+
+	bool contractsStarted = false;
+	for (auto const& [file, names]: contractNamesBySource)
+	{
+		bool sourceStarted = false;
+		for (std::string const& name: names)
+		{
+			std::string const contractName = file + ":" + name;
+
+			// ABI, storage layout, documentation and metadata
+			Json::Value contractData(Json::objectValue);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				contractData["abi"] = compilerStack.contractABI(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+				contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				contractData["metadata"] = compilerStack.metadata(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				contractData["userdoc"] = compilerStack.natspecUser(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				contractData["devdoc"] = compilerStack.natspecDev(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				contractData["ir"] = compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
+				contractData["irAst"] = compilerStack.yulIRAst(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
+				contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
+
+			// EVM
+			Json::Value evmData(Json::objectValue);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+				evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("bytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["bytecode"] = collectEVMObject(
+					_inputsAndSettings.evmVersion,
+					compilerStack.object(contractName),
+					compilerStack.sourceMapping(contractName),
+					compilerStack.generatedSources(contractName),
+					false,
+					[&](std::string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.bytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("deployedBytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["deployedBytecode"] = collectEVMObject(
+					_inputsAndSettings.evmVersion,
+					compilerStack.runtimeObject(contractName),
+					compilerStack.runtimeSourceMapping(contractName),
+					compilerStack.generatedSources(contractName, true),
+					true,
+					[&](std::string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.deployedBytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
+
+			if (!evmData.empty())
+				contractData["evm"] = evmData;
+
+			if (contractData.empty())
+				continue;
+			if (!contractsStarted)
+				_output.beginObject("contracts");
+			if (!sourceStarted)
+				_output.beginObject(file);
+			contractsStarted = sourceStarted = true;
+			_output.member(name, std::move(contractData));
+		}
+		if (sourceStarted)
+			_output.endObject();
+	}
+	if (contractsStarted)
+		_output.endObject();
+
+	if (errors.size() > 0)
+		_output.member("errors", std::move(errors));
+
+	_output.beginObject("sources");
 	unsigned sourceIndex = 0;
 	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
 	// stopAfter: parsing with no parsing errors.
@@ -1490,109 +1788,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
 				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json::Value contractsOutput = Json::objectValue;
-	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
-	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
-
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
-
-		if (!contractData.empty())
-		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			_output.member(sourceName, std::move(sourceResult));
 		}
-	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
-
-	return output;
+	_output.endObject();
 }
 
 
@@ -1742,6 +1940,14 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	Json::Value output = Json::objectValue;
+	OutputWriter writer(output);
+	compile(_input, writer);
+	return output;
+}
+
+void StandardCompiler::compile(Json::Value const& _input, OutputWriter& _output)
 {
 	YulStringRepository::reset();
 
@@ -1749,62 +1955,64 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 	{
 		auto parsed = parseInput(_input);
 		if (std::holds_alternative<Json::Value>(parsed))
-			return std::get<Json::Value>(std::move(parsed));
+		{
+			_output.set(std::get<Json::Value>(std::move(parsed)));
+			return;
+		}
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			compileSolidity(std::move(settings), _output);
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			_output.set(compileYul(std::move(settings)));
 		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
+			compileSolidity(std::move(settings), _output);
 		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
+			_output.set(importEVMAssembly(std::move(settings)));
 		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
-	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON logic exception: ") + _exception.what());
-	}
-	catch (Json::RuntimeError const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON runtime exception: ") + _exception.what());
-	}
-	catch (util::Exception const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+			_output.set(formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language."));
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		_output.fail(formatCurrentException());
 	}
 }
 
 std::string StandardCompiler::compile(std::string const& _input) noexcept
+{
+	std::ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
 {
 	Json::Value input;
 	std::string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
-
+	util::JsonStreamWriter stream(_output, m_jsonPrintingFormat);
+	OutputWriter writer(stream);
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		compile(input, writer);
+		writer.finish();
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		if (!writer.started())
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
@@ -62,11 +62,73 @@ public:
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the serialized output to @a _output. The contracts in the output
+	/// of a Solidity compilation are written one by one, so they are never held in memory as a whole.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
 
+	/**
+	 * Receives the members of the output of a compilation, which have to be passed in the order of
+	 * their keys, and either collects them in a JSON value or writes them to a stream.
+	 * When streaming, the members from ``errors`` on are kept in memory until the output is finished,
+	 * so that an exception can still be reported as a valid output carrying the error.
+	 */
+	class OutputWriter
+	{
+	public:
+		explicit OutputWriter(Json::Value& _output): m_output(&_output), m_objects{&_output} {}
+		explicit OutputWriter(util::JsonStreamWriter& _stream): m_stream(&_stream) {}
+
+		/// Sets the complete output. Nothing must have been passed before.
+		void set(Json::Value const& _output);
+		/// Starts an object as the member @a _key of the current object.
+		void beginObject(std::string const& _key);
+		/// Sets @a _value as the member @a _key of the current object.
+		void member(std::string const& _key, Json::Value _value);
+		/// Ends the current object.
+		void endObject();
+		/// Reports an exception that aborted the compilation, given as the output @a _fatalError.
+		/// When streaming, the members written so far are closed and kept, and the errors replace
+		/// everything that has not been written yet.
+		void fail(Json::Value const& _fatalError);
+		/// Completes the output.
+		void finish();
+
+		/// @returns true if anything has been written to the stream.
+		bool started() const { return m_started; }
+		/// @returns the size of the printed members that are kept in memory until finish().
+		size_t bufferedBytes() const;
+
+	private:
+		/// Part of the output that has not been written to the stream yet. Members are kept
+		/// as printed JSON, so that e.g. the AST of a source does not outlive its member() call.
+		struct TailItem
+		{
+			enum class Kind { BeginObject, Member, EndObject };
+			Kind kind;
+			std::string key;
+			std::string printedValue;
+		};
+
+		void start();
+		/// Starts collecting the output in @a m_tail if @a _key is a top-level member that
+		/// has to be kept back when streaming.
+		void bufferTail(std::string const& _key);
+
+		/// Value the members are collected in when not streaming.
+		Json::Value* m_output = nullptr;
+		/// Objects that are currently being filled when collecting into @a m_output.
+		std::vector<Json::Value*> m_objects;
+
+		util::JsonStreamWriter* m_stream = nullptr;
+		bool m_started = false;
+		bool m_bufferingTail = false;
+		std::vector<TailItem> m_tail;
+	};
+
 private:
 	struct InputsAndSettings
 	{
@@ -95,9 +157,12 @@ private:
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
+	/// Performs the compilation for @a _input and passes the output to @a _output.
+	void compile(Json::Value const& _input, OutputWriter& _output);
+
 	std::map<std::string, Json::Value> parseAstFromInput(StringMap const& _sources);
 	Json::Value importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputWriter& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
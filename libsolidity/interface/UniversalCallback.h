@@ -43,6 +43,8 @@ public:
 				return m_fileReader->readFile(_kind, _data);
 		else if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			return m_solver.solve(_kind, _data);
+		else if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTSession))
+			return m_solver.continueSession(_kind, _data);
 		solAssert(false, "Unknown callback kind.");
 	}
 
@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/ASTIndex.h>
+#include <libsolidity/lsp/Utils.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AST.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+namespace
+{
+
+/// Collects the nodes with their nesting depth and the references to declarations of one source unit.
+class Indexer: public ASTConstVisitor
+{
+public:
+	struct Span
+	{
+		ASTNode const* node;
+		size_t depth;
+	};
+
+	explicit Indexer(std::map<Declaration const*, std::vector<ASTIndex::Reference>>& _references):
+		m_references(_references)
+	{}
+
+	std::vector<Span> const& spans() const { return m_spans; }
+
+	void endVisit(ImportDirective const& _node) override
+	{
+		for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+			if (symbolAlias.alias)
+				addReference(symbolAlias.symbol->annotation().referencedDeclaration, *symbolAlias.alias, symbolAlias.location);
+		endVisitNode(_node);
+	}
+
+	void endVisit(Identifier const& _node) override
+	{
+		addReference(_node.annotation().referencedDeclaration, _node.name(), _node.location());
+		endVisitNode(_node);
+	}
+
+	void endVisit(IdentifierPath const& _node) override
+	{
+		std::vector<Declaration const*> const& declarations = _node.annotation().pathDeclarations;
+		for (size_t i = 0; i < std::min(declarations.size(), _node.path().size()); i++)
+			addReference(declarations[i], _node.path()[i], _node.pathLocations()[i]);
+		endVisitNode(_node);
+	}
+
+	void endVisit(MemberAccess const& _node) override
+	{
+		addReference(_node.annotation().referencedDeclaration, _node.memberName(), _node.memberLocation());
+		endVisitNode(_node);
+	}
+
+	void endVisit(FunctionCall const& _node) override
+	{
+		// Names of named arguments refer to the parameters of the called function.
+		if (auto const* callable = extractCallableDeclaration(_node))
+			for (size_t i = 0; i < _node.names().size(); i++)
+				for (auto const& parameter: callable->parameters())
+					if (_node.names()[i] && parameter && parameter->name() == *_node.names()[i])
+						addReference(parameter.get(), *_node.names()[i], _node.nameLocations()[i]);
+		endVisitNode(_node);
+	}
+
+	void endVisit(InlineAssembly const& _node) override
+	{
+		for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
+		{
+			std::string name = identifier->name.str();
+			if (!externalReference.suffix.empty())
+				name = name.substr(0, name.length() - externalReference.suffix.size() - 1);
+			SourceLocation location = solidity::yul::nativeLocationOf(*identifier);
+			location.end -= static_cast<int>(externalReference.suffix.size() + 1);
+			addReference(externalReference.declaration, std::move(name), std::move(location));
+		}
+		endVisitNode(_node);
+	}
+
+protected:
+	bool visitNode(ASTNode const& _node) override
+	{
+		// Like in locateInnermostASTNode, a node can only be found if all its ancestors have a location.
+		bool const indexed = _node.location().hasText() && (m_indexedPath.empty() || m_indexedPath.back());
+		if (indexed)
+			m_spans.push_back({&_node, m_indexedPath.size()});
+		m_indexedPath.push_back(indexed);
+		return true;
+	}
+
+	void endVisitNode(ASTNode const&) override
+	{
+		m_indexedPath.pop_back();
+	}
+
+private:
+	void addReference(Declaration const* _declaration, ASTString _name, SourceLocation _location)
+	{
+		if (_declaration)
+			m_references[_declaration].push_back({std::move(_name), std::move(_location)});
+	}
+
+	std::map<Declaration const*, std::vector<ASTIndex::Reference>>& m_references;
+	std::vector<Span> m_spans;
+	/// For each node on the path to the current node, whether it was indexed.
+	std::vector<bool> m_indexedPath;
+};
+
+}
+
+ASTIndex::ASTIndex(CompilerStack const& _compilerStack)
+{
+	for (std::string const& sourceUnitName: _compilerStack.sourceNames())
+	{
+		Indexer indexer(m_references);
+		_compilerStack.ast(sourceUnitName).accept(indexer);
+
+		// Sorting by start and then by decreasing end and increasing depth gives an order in which
+		// each node comes after the nodes containing it. The innermost node at any position is
+		// then the top of a stack of the nodes that started but did not end yet.
+		// Among nodes with the same location, the one visited last is the innermost.
+		std::vector<Indexer::Span> spans = indexer.spans();
+		std::stable_sort(spans.begin(), spans.end(), [](Indexer::Span const& _a, Indexer::Span const& _b) {
+			SourceLocation const& a = _a.node->location();
+			SourceLocation const& b = _b.node->location();
+			return std::make_tuple(a.start, -a.end, _a.depth) < std::make_tuple(b.start, -b.end, _b.depth);
+		});
+
+		std::vector<std::pair<int, ASTNode const*>>& innermostNodes = m_innermostNodes[sourceUnitName];
+		auto const setInnermostNode = [&](int _position, ASTNode const* _node) {
+			if (!innermostNodes.empty() && innermostNodes.back().first >= _position)
+				innermostNodes.back().second = _node;
+			else
+				innermostNodes.emplace_back(_position, _node);
+		};
+		std::vector<ASTNode const*> openNodes;
+		auto const closeNodesUntil = [&](int _position) {
+			while (!openNodes.empty() && openNodes.back()->location().end <= _position)
+			{
+				int const end = openNodes.back()->location().end;
+				openNodes.pop_back();
+				setInnermostNode(end, openNodes.empty() ? nullptr : openNodes.back());
+			}
+		};
+		for (Indexer::Span const& span: spans)
+		{
+			closeNodesUntil(span.node->location().start);
+			openNodes.push_back(span.node);
+			setInnermostNode(span.node->location().start, span.node);
+		}
+		closeNodesUntil(std::numeric_limits<int>::max());
+	}
+}
+
+ASTNode const* ASTIndex::innermostNode(std::string const& _sourceUnitName, int _offset) const
+{
+	auto const innermostNodes = m_innermostNodes.find(_sourceUnitName);
+	if (innermostNodes == m_innermostNodes.end() || _offset < 0)
+		return nullptr;
+
+	auto const next = std::upper_bound(
+		innermostNodes->second.begin(),
+		innermostNodes->second.end(),
+		_offset,
+		[](int _position, std::pair<int, ASTNode const*> const& _entry) { return _position < _entry.first; }
+	);
+	if (next == innermostNodes->second.begin())
+		return nullptr;
+	return std::prev(next)->second;
+}
+
+std::vector<ASTIndex::Reference> const& ASTIndex::references(Declaration const& _declaration) const
+{
+	static std::vector<Reference> const noReferences;
+	auto const references = m_references.find(&_declaration);
+	return references == m_references.end() ? noReferences : references->second;
+}
@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::lsp
+{
+
+/**
+ * Index over the ASTs of an analyzed compiler stack, built once per analysis,
+ * that answers position and reference queries without traversing the ASTs again.
+ */
+class ASTIndex
+{
+public:
+	/// A location in the sources at which a declaration is referenced under the given name.
+	struct Reference
+	{
+		frontend::ASTString name;
+		langutil::SourceLocation location;
+	};
+
+	ASTIndex() = default;
+	explicit ASTIndex(frontend::CompilerStack const& _compilerStack);
+
+	/// @returns the innermost AST node whose location contains @a _offset in the given source unit,
+	/// or nullptr if there is none. Equivalent to locateInnermostASTNode.
+	frontend::ASTNode const* innermostNode(std::string const& _sourceUnitName, int _offset) const;
+
+	/// @returns all references to @a _declaration in the sources. The name location
+	/// of the declaration itself is not included.
+	std::vector<Reference> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	/// Per source unit, the positions at which the innermost node changes, sorted by position,
+	/// together with the innermost node from that position on (nullptr if there is none).
+	std::map<std::string, std::vector<std::pair<int, frontend::ASTNode const*>>> m_innermostNodes;
+	std::map<frontend::Declaration const*, std::vector<Reference>> m_references;
+};
+
+}
@@ -48,6 +48,13 @@ FileRepository::FileRepository(boost::filesystem::path _basePath, std::vector<bo
 {
 }
 
+FileRepository FileRepository::withoutSources() const
+{
+	FileRepository repository(m_basePath, m_includePaths);
+	repository.m_fileCache = m_fileCache;
+	return repository;
+}
+
 void FileRepository::setIncludePaths(std::vector<boost::filesystem::path> _paths)
 {
 	m_includePaths = std::move(_paths);
@@ -101,6 +108,11 @@ void FileRepository::setSourceByUri(std::string const& _uri, std::string _source
 	m_sourceCodes[sourceUnitName] = std::move(_source);
 }
 
+void FileRepository::setSourceUnits(StringMap _sources)
+{
+	m_sourceCodes = std::move(_sources);
+}
+
 Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const& _strippedSourceUnitName) const
 {
 	if (
@@ -154,21 +166,28 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 		"ReadFile callback used as callback kind " + _kind
 	);
 
+	// File was read already. Use local store.
+	if (m_sourceCodes.count(_sourceUnitName))
+		return ReadCallback::Result{true, m_sourceCodes.at(_sourceUnitName)};
+
+	ReadCallback::Result result = readFileFromDisk(_sourceUnitName);
+	if (result.success)
+		m_sourceCodes[_sourceUnitName] = result.responseOrErrorMessage;
+	else
+		m_unreadableSourceUnits.insert(_sourceUnitName);
+	return result;
+}
+
+frontend::ReadCallback::Result FileRepository::readFileFromDisk(std::string const& _sourceUnitName) const
+{
 	try
 	{
-		// File was read already. Use local store.
-		if (m_sourceCodes.count(_sourceUnitName))
-			return ReadCallback::Result{true, m_sourceCodes.at(_sourceUnitName)};
-
 		std::string const strippedSourceUnitName = stripFileUriSchemePrefix(_sourceUnitName);
 		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(strippedSourceUnitName);
 		if (!resolvedPath.message().empty())
 			return ReadCallback::Result{false, resolvedPath.message()};
 
-		auto contents = readFileAsString(resolvedPath.get());
-		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, std::move(contents)};
+		return ReadCallback::Result{true, readFileCached(resolvedPath.get())};
 	}
 	catch (std::exception const& _exception)
 	{
@@ -180,3 +199,25 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 	}
 }
 
+std::string const& FileRepository::readFileCached(boost::filesystem::path const& _path) const
+{
+	// Modification times can be as coarse as two seconds. A file that was modified this shortly
+	// before it was read may have been modified again without changing its modification time
+	// or size, so its cached content is only trusted once it is older than that.
+	std::time_t const modificationTimeGranularity = 2;
+
+	std::time_t const lastWriteTime = boost::filesystem::last_write_time(_path);
+	uintmax_t const size = boost::filesystem::file_size(_path);
+	auto cached = m_fileCache->find(_path);
+	if (
+		cached == m_fileCache->end() ||
+		cached->second.lastWriteTime != lastWriteTime ||
+		cached->second.size != size ||
+		cached->second.readTime - lastWriteTime <= modificationTimeGranularity
+	)
+	{
+		std::time_t const readTime = std::time(nullptr);
+		cached = m_fileCache->insert_or_assign(_path, CachedFile{lastWriteTime, size, readTime, readFileAsString(_path)}).first;
+	}
+	return cached->second.content;
+}
@@ -20,8 +20,11 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
-#include <string>
+#include <ctime>
 #include <map>
+#include <memory>
+#include <set>
+#include <string>
 
 namespace solidity::lsp
 {
@@ -31,6 +34,10 @@ class FileRepository
 public:
 	FileRepository(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths);
 
+	/// @returns a repository with the same paths and the same cache of files read from disk,
+	/// but without any sources.
+	FileRepository withoutSources() const;
+
 	std::vector<boost::filesystem::path> const& includePaths() const noexcept { return m_includePaths; }
 	void setIncludePaths(std::vector<boost::filesystem::path> _paths);
 
@@ -45,6 +52,9 @@ public:
 	/// @returns all sources by their compiler-internal source unit name.
 	StringMap const& sourceUnits() const noexcept { return m_sourceCodes; }
 
+	/// @returns the names of source units that the read callback failed to read.
+	std::set<std::string> const& unreadableSourceUnits() const noexcept { return m_unreadableSourceUnits; }
+
 	/// Changes the source identified by the LSP client path _uri to _text.
 	void setSourceByUri(std::string const& _uri, std::string _text);
 
@@ -55,9 +65,26 @@ public:
 		return [this](std::string const& _kind, std::string const& _path) { return readFile(_kind, _path); };
 	}
 
+	/// Resolves the source unit @a _sourceUnitName and reads it from disk, without adding it to the repository.
+	frontend::ReadCallback::Result readFileFromDisk(std::string const& _sourceUnitName) const;
+
+	/// @returns the content of the file at @a _path. Files are only read again if their modification
+	/// time or size changed since the last time they were read by this or a related repository,
+	/// or if they had been modified too shortly before that read to rule out a later modification.
+	std::string const& readFileCached(boost::filesystem::path const& _path) const;
+
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
 private:
+	struct CachedFile
+	{
+		std::time_t lastWriteTime;
+		uintmax_t size;
+		/// Time at which the file was read.
+		std::time_t readTime;
+		std::string content;
+	};
+
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
 
@@ -69,6 +96,12 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	/// Source units that could not be read by the read callback.
+	std::set<std::string> m_unreadableSourceUnits;
+
+	/// Contents of files read from disk by their path, shared with the repositories created by withoutSources().
+	std::shared_ptr<std::map<boost::filesystem::path, CachedFile>> m_fileCache = std::make_shared<std::map<boost::filesystem::path, CachedFile>>();
 };
 
 }
@@ -18,6 +18,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
@@ -41,8 +42,11 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <chrono>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <tuple>
 
 #include <fmt/format.h>
 
@@ -58,6 +62,9 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Time to wait before an analysis starts, so that a burst of changes only leads to one analysis.
+constexpr std::chrono::milliseconds analysisDebounceDelay{50};
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -128,6 +135,51 @@ Json::Value semanticTokensLegend()
 	return legend;
 }
 
+/// @returns a single edit that turns the encoded semantic tokens @a _previous into @a _current,
+/// or no edit if they are equal.
+Json::Value semanticTokensEdits(Json::Value const& _previous, Json::Value const& _current)
+{
+	Json::ArrayIndex const commonSize = std::min(_previous.size(), _current.size());
+	Json::ArrayIndex prefix = 0;
+	while (prefix < commonSize && _previous[prefix] == _current[prefix])
+		++prefix;
+	Json::ArrayIndex suffix = 0;
+	while (suffix < commonSize - prefix && _previous[_previous.size() - 1 - suffix] == _current[_current.size() - 1 - suffix])
+		++suffix;
+
+	Json::Value edits = Json::arrayValue;
+	if (prefix + suffix == _previous.size() && prefix + suffix == _current.size())
+		return edits;
+
+	Json::Value edit = Json::objectValue;
+	edit["start"] = prefix;
+	edit["deleteCount"] = _previous.size() - prefix - suffix;
+	edit["data"] = Json::arrayValue;
+	for (Json::ArrayIndex i = prefix; i < _current.size() - suffix; ++i)
+		edit["data"].append(_current[i]);
+	edits.append(std::move(edit));
+	return edits;
+}
+
+Json::Value toRange(CharStreamProvider const& _charStreamProvider, SourceLocation const& _location)
+{
+	if (!_location.hasText())
+		return toJsonRange({}, {});
+
+	solAssert(_location.sourceName);
+	CharStream const& stream = _charStreamProvider.charStream(*_location.sourceName);
+	return toJsonRange(
+		stream.translatePositionToLineColumn(_location.start),
+		stream.translatePositionToLineColumn(_location.end)
+	);
+}
+
+}
+
+LanguageServer::Snapshot::Snapshot(FileRepository _fileRepository):
+	fileRepository(std::move(_fileRepository)),
+	compilerStack(fileRepository.reader())
+{
 }
 
 LanguageServer::LanguageServer(Transport& _transport):
@@ -148,21 +200,26 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/rename", RenameSymbol(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
 		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/semanticTokens/full/delta", std::bind(&LanguageServer::semanticTokensFullDelta, this, _1, _2)},
+		{"textDocument/semanticTokens/range", std::bind(&LanguageServer::semanticTokensRange, this, _1, _2)},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
-{
-}
-
-Json::Value LanguageServer::toRange(SourceLocation const& _location)
+	m_snapshot{std::make_shared<Snapshot>(FileRepository("/", {}))}
 {
-	return HandlerBase(*this).toRange(_location);
 }
 
-Json::Value LanguageServer::toJson(SourceLocation const& _location)
+LanguageServer::~LanguageServer()
 {
-	return HandlerBase(*this).toJson(_location);
+	if (m_cancelLatestAnalysis)
+		*m_cancelLatestAnalysis = true;
+	{
+		std::lock_guard<std::mutex> lock(m_snapshotMutex);
+		m_latestSnapshot.reset();
+	}
+	m_snapshot.reset();
+	// Waits for the analyses, which destroy their snapshots now that they are no longer used.
+	m_analyses.clear();
 }
 
 void LanguageServer::changeConfiguration(Json::Value const& _settings)
@@ -213,7 +270,7 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(fs::path const& _basePath)
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -221,9 +278,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -235,52 +292,186 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+void LanguageServer::compileAndUpdateDiagnostics()
+{
+	if (m_cancelLatestAnalysis)
+		*m_cancelLatestAnalysis = true;
+	m_cancelLatestAnalysis = std::make_shared<std::atomic<bool>>(false);
+
+	AnalysisRequest request{
+		++m_scheduledVersion,
+		m_fileRepository.withoutSources(),
+		m_fileLoadStrategy,
+		{},
+		m_cancelLatestAnalysis
+	};
+	for (std::string const& uri: m_openFiles)
+		request.openDocuments[uri] = m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(uri));
+
+	m_analyses.remove_if([](std::future<void> const& _analysis) {
+		return _analysis.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	});
+	m_analyses.emplace_back(std::async(std::launch::async, &LanguageServer::analyze, this, std::move(request)));
+}
+
+void LanguageServer::analyze(AnalysisRequest _request)
 {
-	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
+	std::this_thread::sleep_for(analysisDebounceDelay);
+	if (*_request.cancelled)
+		return;
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	// The snapshot is owned by this thread, which destroys it once it is no longer used.
+	std::unique_ptr<Snapshot> snapshot;
+	std::promise<void> snapshotReleased;
+	bool published = false;
+	try
+	{
+		std::lock_guard<std::mutex> analysisLock(m_analysisMutex);
+		if (*_request.cancelled)
+			return;
+
+		// For files that are not open, we have to take changes on disk into account,
+		// so we start without any sources. Files that did not change on disk are not read again.
+		FileRepository& repository = _request.fileRepository;
+
+		// Load all solidity files from project.
+		if (_request.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+			for (auto const& projectFile: allSolidityFilesFromProject(repository.basePath()))
+			{
+				lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
+				repository.setSourceByUri(
+					repository.sourceUnitNameToUri(projectFile.generic_string()),
+					repository.readFileCached(projectFile)
+				);
+			}
+
+		// Overwrite all files as opened by the client, including the ones which might potentially have changes.
+		for (auto&& [uri, content]: _request.openDocuments)
+			repository.setSourceByUri(uri, std::move(content));
+
+		std::shared_ptr<Snapshot const> latestSnapshot;
+		{
+			std::lock_guard<std::mutex> lock(m_snapshotMutex);
+			latestSnapshot = m_latestSnapshot;
+		}
+		if (
+			latestSnapshot &&
+			latestSnapshot->compiledSources == repository.sourceUnits() &&
+			importedFilesUnchanged(*latestSnapshot, repository)
+		)
+		{
+			publishDiagnostics(*latestSnapshot);
+			finishAnalysis(_request.version);
+			return;
+		}
+
+		snapshot = std::make_unique<Snapshot>(std::move(repository));
+		StringMap sources = snapshot->fileRepository.sourceUnits();
+		snapshot->compilerStack.setCancellationCheck([cancelled = _request.cancelled]() { return cancelled->load(); });
+		snapshot->compilerStack.setSources(sources);
+		snapshot->compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+		snapshot->compiledSources = std::move(sources);
+		if (snapshot->compilerStack.state() >= CompilerStack::AnalysisSuccessful)
+			snapshot->astIndex = ASTIndex(snapshot->compilerStack);
 
-	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
 		{
-			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+			std::shared_ptr<Snapshot const> publishedSnapshot(
+				snapshot.get(),
+				[&](Snapshot const*) { snapshotReleased.set_value(); }
 			);
+			std::lock_guard<std::mutex> lock(m_snapshotMutex);
+			if (*_request.cancelled)
+				return;
+			m_latestSnapshot = std::move(publishedSnapshot);
+			published = true;
 		}
+		publishDiagnostics(*snapshot);
+		finishAnalysis(_request.version);
+	}
+	catch (CompilationCancelled const&)
+	{
+	}
+	catch (...)
+	{
+		m_client.error({}, ErrorCode::InternalError, "Unhandled exception during analysis: "s + boost::current_exception_diagnostic_information());
+		finishAnalysis(_request.version);
+	}
 
-	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+	if (published)
+		snapshotReleased.get_future().wait();
+}
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+void LanguageServer::finishAnalysis(uint64_t _version)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_snapshotMutex);
+		m_analyzedVersion = std::max(m_analyzedVersion, _version);
+	}
+	m_analysisFinished.notify_all();
+}
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+void LanguageServer::waitForAnalysis()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_snapshotMutex);
+		m_analysisFinished.wait(lock, [&]() { return m_analyzedVersion == m_scheduledVersion; });
+	}
+	updateSnapshot();
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::updateSnapshot()
 {
-	compile();
+	std::shared_ptr<Snapshot const> latestSnapshot;
+	{
+		std::lock_guard<std::mutex> lock(m_snapshotMutex);
+		latestSnapshot = m_latestSnapshot;
+	}
+	if (!latestSnapshot || latestSnapshot == m_snapshot)
+		return;
+
+	// Take the sources of the snapshot, but keep the current content of the open documents,
+	// which may have changed since the analysis was scheduled.
+	FileRepository repository = m_fileRepository.withoutSources();
+	repository.setSourceUnits(latestSnapshot->fileRepository.sourceUnits());
+	for (std::string const& uri: m_openFiles)
+		repository.setSourceByUri(uri, m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(uri)));
+	m_fileRepository = std::move(repository);
+	// The types of the previous snapshot must not be active anymore once it is released.
+	bool const typesActive = m_snapshotTypes.has_value();
+	m_snapshotTypes.reset();
+	m_snapshot = std::move(latestSnapshot);
+	if (typesActive)
+		m_snapshotTypes.emplace(m_snapshot->compilerStack.typeProvider());
+}
+
+bool LanguageServer::importedFilesUnchanged(Snapshot const& _snapshot, FileRepository const& _repository)
+{
+	for (auto const& [sourceUnitName, content]: _snapshot.fileRepository.sourceUnits())
+		if (!_snapshot.compiledSources.count(sourceUnitName))
+		{
+			ReadCallback::Result const result = _repository.readFileFromDisk(sourceUnitName);
+			if (!result.success || result.responseOrErrorMessage != content)
+				return false;
+		}
+	for (std::string const& sourceUnitName: _snapshot.fileRepository.unreadableSourceUnits())
+		if (_repository.readFileFromDisk(sourceUnitName).success)
+			return false;
+	return true;
+}
+
+void LanguageServer::publishDiagnostics(Snapshot const& _snapshot)
+{
+	FileRepository const& repository = _snapshot.fileRepository;
 
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json::Value> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (std::string const& sourceUnitName: repository.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: _snapshot.compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -295,14 +486,16 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		if (std::string const* comment = error->comment())
 			message += " " + *comment;
 		jsonDiag["message"] = std::move(message);
-		jsonDiag["range"] = toRange(*location);
+		jsonDiag["range"] = toRange(_snapshot.compilerStack, *location);
 
 		if (auto const* secondary = error->secondarySourceLocation())
 			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
 			{
 				Json::Value jsonRelated;
 				jsonRelated["message"] = secondaryMessage;
-				jsonRelated["location"] = toJson(secondaryLocation);
+				solAssert(secondaryLocation.sourceName);
+				jsonRelated["location"]["uri"] = repository.sourceUnitNameToUri(*secondaryLocation.sourceName);
+				jsonRelated["location"]["range"] = toRange(_snapshot.compilerStack, secondaryLocation);
 				jsonDiag["relatedInformation"].append(jsonRelated);
 			}
 
@@ -320,7 +513,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json::Value params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = repository.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = std::move(diagnostics);
@@ -339,6 +532,11 @@ bool LanguageServer::run()
 			if (!jsonMessage)
 				continue;
 
+			updateSnapshot();
+			// Types created while answering queries belong to the snapshot and are released with it.
+			m_snapshotTypes.emplace(m_snapshot->compilerStack.typeProvider());
+			ScopeGuard releaseSnapshotTypes([&]() { m_snapshotTypes.reset(); });
+
 			if ((*jsonMessage)["method"].isString())
 			{
 				std::string const methodName = (*jsonMessage)["method"].asString();
@@ -419,8 +617,8 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["semanticTokensProvider"]["legend"] = semanticTokensLegend();
-	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = false;
-	replyArgs["capabilities"]["semanticTokensProvider"]["full"] = true; // XOR requests.full.delta = true
+	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = true;
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
 	replyArgs["capabilities"]["renameProvider"] = true;
 	replyArgs["capabilities"]["hoverProvider"] = true;
 
@@ -433,19 +631,98 @@ void LanguageServer::handleInitialized(MessageID, Json::Value const&)
 		compileAndUpdateDiagnostics();
 }
 
+Json::Value const& LanguageServer::semanticTokens(std::string const& _sourceUnitName)
+{
+	if (!m_snapshot->fileRepository.sourceUnits().count(_sourceUnitName))
+		// The document was opened only recently.
+		waitForAnalysis();
+
+	auto tokens = m_snapshot->semanticTokens.find(_sourceUnitName);
+	if (tokens == m_snapshot->semanticTokens.end())
+		tokens = m_snapshot->semanticTokens.emplace(
+			_sourceUnitName,
+			SemanticTokensBuilder().build(compilerStack().ast(_sourceUnitName), compilerStack().charStream(_sourceUnitName))
+		).first;
+	return tokens->second;
+}
+
+std::string LanguageServer::rememberSemanticTokens(std::string const& _uri, Json::Value const& _tokens)
+{
+	auto& [resultId, tokens] = m_semanticTokensResults[_uri];
+	tokens = _tokens;
+	return std::to_string(++resultId);
+}
+
 void LanguageServer::semanticTokensFull(MessageID _id, Json::Value const& _args)
 {
-	auto uri = _args["textDocument"]["uri"];
+	std::string const uri = _args["textDocument"]["uri"].asString();
+	Json::Value const& tokens = semanticTokens(m_fileRepository.uriToSourceUnitName(uri));
+
+	Json::Value reply = Json::objectValue;
+	reply["resultId"] = rememberSemanticTokens(uri, tokens);
+	reply["data"] = tokens;
+
+	m_client.reply(_id, std::move(reply));
+}
 
-	compile();
+void LanguageServer::semanticTokensFullDelta(MessageID _id, Json::Value const& _args)
+{
+	std::string const uri = _args["textDocument"]["uri"].asString();
+	Json::Value const& tokens = semanticTokens(m_fileRepository.uriToSourceUnitName(uri));
+
+	// Without the previous result, the client gets all tokens instead of the edits.
+	Json::Value reply = Json::objectValue;
+	auto const previous = m_semanticTokensResults.find(uri);
+	if (previous != m_semanticTokensResults.end() && std::to_string(previous->second.first) == _args["previousResultId"].asString())
+		reply["edits"] = semanticTokensEdits(previous->second.second, tokens);
+	else
+		reply["data"] = tokens;
+	reply["resultId"] = rememberSemanticTokens(uri, tokens);
 
-	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<std::string>());
-	SourceUnit const& ast = m_compilerStack.ast(sourceName);
-	m_compilerStack.charStream(sourceName);
-	Json::Value data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensRange(MessageID _id, Json::Value const& _args)
+{
+	std::string const uri = _args["textDocument"]["uri"].asString();
+	std::optional<LineColumn> const start = parseLineColumn(_args["range"]["start"]);
+	std::optional<LineColumn> const end = parseLineColumn(_args["range"]["end"]);
+	lspRequire(
+		start && end,
+		ErrorCode::InvalidParams,
+		"Invalid range: " + util::jsonCompactPrint(_args["range"])
+	);
+	Json::Value const& tokens = semanticTokens(m_fileRepository.uriToSourceUnitName(uri));
+
+	// The tokens are encoded relative to the previous token, so they are decoded
+	// and the ones inside the range are encoded again relative to each other.
+	Json::Value data = Json::arrayValue;
+	int line = 0;
+	int startChar = 0;
+	int lastLine = 0;
+	int lastStartChar = 0;
+	for (Json::ArrayIndex i = 0; i + 4 < tokens.size(); i += 5)
+	{
+		int const deltaLine = tokens[i].asInt();
+		line += deltaLine;
+		startChar = (deltaLine == 0 ? startChar : 0) + tokens[i + 1].asInt();
+		if (
+			std::make_tuple(line, startChar) < std::make_tuple(start->line, start->column) ||
+			std::make_tuple(line, startChar) >= std::make_tuple(end->line, end->column)
+		)
+			continue;
+
+		data.append(line - lastLine);
+		data.append(line == lastLine ? startChar - lastStartChar : startChar);
+		data.append(tokens[i + 2]);
+		data.append(tokens[i + 3]);
+		data.append(tokens[i + 4]);
+		lastLine = line;
+		lastStartChar = startChar;
+	}
 
 	Json::Value reply = Json::objectValue;
-	reply["data"] = data;
+	reply["data"] = std::move(data);
 
 	m_client.reply(_id, std::move(reply));
 }
@@ -543,6 +820,7 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 
 	std::string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.erase(uri);
+	m_semanticTokensResults.erase(uri);
 
 	compileAndUpdateDiagnostics();
 }
@@ -554,14 +832,14 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	if (compilerStack().state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!m_snapshot->fileRepository.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack().charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {astIndex().innermostNode(_sourceUnitName, *sourcePos), *sourcePos};
 }
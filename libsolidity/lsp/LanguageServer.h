@@ -17,15 +17,24 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/lsp/ASTIndex.h>
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <json/value.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -57,16 +66,25 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Messages are handled on the thread calling run(), while the project is analyzed on
+ * background threads. Queries are answered from the snapshot of the last completed analysis.
  */
 class LanguageServer
 {
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
+	~LanguageServer();
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Schedules a re-analysis of the project in the background, which updates the diagnostics
+	/// pushed to the client once it is done. Cancels the analysis scheduled before, if it is
+	/// still running.
 	void compileAndUpdateDiagnostics();
 
+	/// Blocks until the latest scheduled analysis is done and answers queries from its result.
+	void waitForAnalysis();
+
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
 	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
@@ -79,7 +97,8 @@ public:
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	frontend::CompilerStack const& compilerStack() const noexcept { return m_snapshot->compilerStack; }
+	ASTIndex const& astIndex() const noexcept { return m_snapshot->astIndex; }
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -95,20 +114,67 @@ private:
 	void handleRename(Json::Value const& _args);
 	void handleGotoDefinition(MessageID _id, Json::Value const& _args);
 	void semanticTokensFull(MessageID _id, Json::Value const& _args);
+	void semanticTokensFullDelta(MessageID _id, Json::Value const& _args);
+	void semanticTokensRange(MessageID _id, Json::Value const& _args);
+
+	/// @returns the encoded semantic tokens of the given source unit in the current snapshot.
+	Json::Value const& semanticTokens(std::string const& _sourceUnitName);
+	/// Stores @a _tokens as the last semantic tokens sent for @a _uri.
+	/// @returns the result ID identifying them.
+	std::string rememberSemanticTokens(std::string const& _uri, Json::Value const& _tokens);
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
-
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
+	/// Result of an analysis of the project.
+	struct Snapshot
+	{
+		explicit Snapshot(FileRepository _fileRepository);
+
+		/// The sources of the analysis, including the files read from disk during compilation.
+		FileRepository fileRepository;
+		frontend::CompilerStack compilerStack;
+		/// The sources the compiler stack was compiled with.
+		StringMap compiledSources;
+		/// Index over the ASTs, empty unless the analysis was successful.
+		ASTIndex astIndex;
+		/// Encoded semantic tokens by source unit name, computed when first requested.
+		/// Only accessed by the thread handling the messages.
+		mutable std::map<std::string, Json::Value> semanticTokens;
+	};
+
+	/// Everything an analysis needs to know, copied when it is scheduled.
+	struct AnalysisRequest
+	{
+		uint64_t version;
+		/// Repository without sources, but with the paths and the file cache of the server.
+		FileRepository fileRepository;
+		FileLoadStrategy fileLoadStrategy;
+		/// Content of the files opened by the client, by their URI.
+		StringMap openDocuments;
+		std::shared_ptr<std::atomic<bool>> cancelled;
+	};
+
+	/// Compiles everything until after analysis phase on the calling thread, unless neither
+	/// the sources nor the files they import changed since the last analysis, and publishes the
+	/// result and its diagnostics. The compiler stack is destroyed on the same thread once the
+	/// snapshot is no longer used.
+	void analyze(AnalysisRequest _request);
+	/// Sends the diagnostics of @a _snapshot to the client.
+	void publishDiagnostics(Snapshot const& _snapshot);
+	/// Marks all analyses up to @a _version as done.
+	void finishAnalysis(uint64_t _version);
+	/// Answers queries from the last completed analysis, if it is newer than the one used so far.
+	void updateSnapshot();
+
+	/// @returns true if the files that were read from disk during the compilation of
+	/// @a _snapshot would still be read with the same result by @a _repository.
+	static bool importedFilesUnchanged(Snapshot const& _snapshot, FileRepository const& _repository);
+
+	static std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath);
 
 	using MessageHandler = std::function<void(MessageID, Json::Value const&)>;
 
-	Json::Value toRange(langutil::SourceLocation const& _location);
-	Json::Value toJson(langutil::SourceLocation const& _location);
-
 	// LSP related member fields
 
 	enum class State { Started, Initialized, ShutdownRequested, ExitRequested, ExitWithoutShutdown };
@@ -120,11 +186,38 @@ private:
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
 	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	/// Only accessed while holding m_analysisMutex.
 	std::set<std::string> m_nonemptyDiagnostics;
+	/// The documents opened by the client and the sources of m_snapshot.
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
-	frontend::CompilerStack m_compilerStack;
+	/// The analysis queries are answered from.
+	std::shared_ptr<Snapshot const> m_snapshot;
+	/// Activates the types of m_snapshot on the thread calling run() while a message is handled.
+	std::optional<frontend::TypeProvider::Activation> m_snapshotTypes;
+
+	/// The last semantic tokens sent to the client by document URI, together with their result ID.
+	/// Result IDs are numbered per document.
+	std::map<std::string, std::pair<uint64_t, Json::Value>> m_semanticTokensResults;
+
+	/// Analyses that were started and might still be running.
+	std::list<std::future<void>> m_analyses;
+	/// Version of the latest scheduled analysis.
+	uint64_t m_scheduledVersion = 0;
+	/// Cancellation flag of the latest scheduled analysis.
+	std::shared_ptr<std::atomic<bool>> m_cancelLatestAnalysis;
+	/// Ensures that only one analysis runs at a time. This also protects the file cache
+	/// shared by the repositories.
+	std::mutex m_analysisMutex;
+
+	/// Protects m_latestSnapshot and m_analyzedVersion.
+	std::mutex m_snapshotMutex;
+	std::condition_variable m_analysisFinished;
+	/// The result of the last completed analysis.
+	std::shared_ptr<Snapshot const> m_latestSnapshot;
+	/// All analyses up to this version are done.
+	uint64_t m_analyzedVersion = 0;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
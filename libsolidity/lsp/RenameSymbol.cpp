@@ -30,25 +30,11 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 using namespace solidity::lsp;
 
-namespace
-{
-
-CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _functionCall)
-{
-	if (
-		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
-		functionType && functionType->hasDeclaration()
-	)
-		if (auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
-			return functionDefinition;
-
-	return nullptr;
-}
-
-}
-
 void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 {
+	// The edits have to match the current content of the documents.
+	m_server.waitForAnalysis();
+
 	auto const&& [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
 	std::string const newName = _args["newName"].asString();
 	std::string const uri = _args["textDocument"]["uri"].asString();
@@ -57,7 +43,6 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 
 	m_symbolName = {};
 	m_declarationToRename = nullptr;
-	m_sourceUnits = { &m_server.compilerStack().ast(sourceUnitName) };
 	m_locations.clear();
 
 	std::optional<int> cursorBytePosition = charStreamProvider()
@@ -67,25 +52,11 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 
 	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
 
-	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
-	{
-		auto const& sourceUnit = m_server.compilerStack().ast(name);
-		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<std::set<SourceUnit const*>>(m_sourceUnits)))
-			if (*referencedSourceUnit->location().sourceName == sourceUnitName)
-			{
-				m_sourceUnits.insert(&sourceUnit);
-				break;
-			}
-	}
-
-	// Origin source unit should always be checked
-	m_sourceUnits.insert(&m_declarationToRename->sourceUnit());
-
-	Visitor visitor(*this);
-
-	for (auto const* sourceUnit: m_sourceUnits)
-		sourceUnit->accept(visitor);
+	if (m_declarationToRename->name() == m_symbolName && m_declarationToRename->nameLocation().hasText())
+		m_locations.emplace_back(m_declarationToRename->nameLocation());
+	for (ASTIndex::Reference const& reference: m_server.astIndex().references(*m_declarationToRename))
+		if (reference.name == m_symbolName)
+			m_locations.emplace_back(reference.location);
 
 	// Apply changes in reverse order (will iterate in reverse)
 	sort(m_locations.begin(), m_locations.end());
@@ -171,21 +142,6 @@ void RenameSymbol::extractNameAndDeclaration(ImportDirective const& _importDirec
 		}
 }
 
-void RenameSymbol::Visitor::endVisit(ImportDirective const& _node)
-{
-	// Handles SourceUnit aliases
-	if (handleGenericDeclaration(_node))
-		return;
-
-	for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
-		if (
-			symbolAlias.alias != nullptr &&
-			*symbolAlias.alias == m_outer.m_symbolName &&
-			symbolAlias.symbol->annotation().referencedDeclaration == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(symbolAlias.location);
-}
-
 void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall, int _cursorBytePosition)
 {
 	if (auto const* functionDefinition = extractCallableDeclaration(_functionCall))
@@ -203,44 +159,6 @@ void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall,
 			}
 }
 
-void RenameSymbol::Visitor::endVisit(FunctionCall const& _node)
-{
-	SourceLocation nameLocationInFunctionCall;
-
-	for (size_t i = 0; i < _node.names().size(); i++)
-		if (_node.names()[i] && *_node.names()[i] == m_outer.m_symbolName)
-			nameLocationInFunctionCall = _node.nameLocations()[i];
-
-	if (!nameLocationInFunctionCall.isValid())
-		return;
-
-	if (auto const* functionDefinition = extractCallableDeclaration(_node))
-		for (size_t j = 0; j < functionDefinition->parameters().size(); j++)
-			if (
-				functionDefinition->parameters()[j] &&
-				*functionDefinition->parameters()[j] == *m_outer.m_declarationToRename
-			)
-				m_outer.m_locations.emplace_back(nameLocationInFunctionCall);
-}
-
-void RenameSymbol::Visitor::endVisit(MemberAccess const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.memberName() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.memberLocation());
-}
-
-void RenameSymbol::Visitor::endVisit(Identifier const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.name() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.location());
-}
-
 void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPath, int _cursorBytePosition)
 {
 	// iterate through the elements of the path to find the one the cursor is on
@@ -260,19 +178,6 @@ void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPa
 	}
 }
 
-void RenameSymbol::Visitor::endVisit(IdentifierPath const& _node)
-{
-	std::vector<Declaration const*>& declarations = _node.annotation().pathDeclarations;
-	solAssert(declarations.size() == _node.path().size());
-
-	for (size_t i = 0; i < _node.path().size(); i++)
-		if (
-			_node.path()[i] == m_outer.m_symbolName &&
-			declarations[i] == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(_node.pathLocations()[i]);
-}
-
 void RenameSymbol::extractNameAndDeclaration(InlineAssembly const& _inlineAssembly, int _cursorBytePosition)
 {
 	for (auto&& [identifier, externalReference]: _inlineAssembly.annotation().externalReferences)
@@ -291,25 +196,3 @@ void RenameSymbol::extractNameAndDeclaration(InlineAssembly const& _inlineAssemb
 		}
 	}
 }
-
-void RenameSymbol::Visitor::endVisit(InlineAssembly const& _node)
-{
-	for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
-	{
-		std::string identifierName = identifier->name.str();
-		if (!externalReference.suffix.empty())
-			identifierName = identifierName.substr(0, identifierName.length() - externalReference.suffix.size() - 1);
-
-		if (
-			externalReference.declaration == m_outer.m_declarationToRename &&
-			identifierName == m_outer.m_symbolName
-		)
-		{
-			SourceLocation location = yul::nativeLocationOf(*identifier);
-			location.end -= static_cast<int>(externalReference.suffix.size() + 1);
-
-			m_outer.m_locations.emplace_back(location);
-		}
-	}
-
-}
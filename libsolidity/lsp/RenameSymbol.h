@@ -17,7 +17,6 @@
 // SPDX-License-Identifier: GPL-3.0
 #include <libsolidity/lsp/HandlerBase.h>
 #include <libsolidity/ast/AST.h>
-#include <libsolidity/ast/ASTVisitor.h>
 
 namespace solidity::lsp
 {
@@ -29,77 +28,6 @@ public:
 
 	void operator()(MessageID, Json::Value const&);
 protected:
-	// Nested class because otherwise `RenameSymbol` couldn't be easily used
-	// with LanguageServer::m_handlers as `ASTConstVisitor` deletes required
-	// c'tors
-	struct Visitor: public frontend::ASTConstVisitor
-	{
-		explicit Visitor(RenameSymbol& _outer): m_outer(_outer) {}
-		void endVisit(frontend::ImportDirective const& _node) override;
-		void endVisit(frontend::MemberAccess const& _node) override;
-		void endVisit(frontend::Identifier const& _node) override;
-		void endVisit(frontend::IdentifierPath const& _node) override;
-		void endVisit(frontend::FunctionCall const& _node) override;
-		void endVisit(frontend::InlineAssembly const& _node) override;
-
-		void endVisit(frontend::ContractDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::StructDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::EnumDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::EnumValue const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::UserDefinedValueTypeDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::VariableDeclaration const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::FunctionDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::ModifierDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::EventDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-		void endVisit(frontend::ErrorDefinition const& _node) override
-		{
-			handleGenericDeclaration(_node);
-		}
-
-		bool handleGenericDeclaration(frontend::Declaration const& _declaration)
-		{
-			if (
-				m_outer.m_symbolName == _declaration.name() &&
-				*m_outer.m_declarationToRename == _declaration
-			)
-			{
-				m_outer.m_locations.emplace_back(_declaration.nameLocation());
-				return true;
-			}
-			return false;
-		}
-
-		private:
-			RenameSymbol& m_outer;
-	};
-
 	void extractNameAndDeclaration(frontend::ASTNode const& _node, int _cursorBytePosition);
 	void extractNameAndDeclaration(frontend::IdentifierPath const& _identifierPath, int _cursorBytePosition);
 	void extractNameAndDeclaration(frontend::ImportDirective const& _importDirective, int _cursorBytePosition);
@@ -110,8 +38,6 @@ protected:
 	frontend::Declaration const* m_declarationToRename = nullptr;
 	// Original name
 	frontend::ASTString m_symbolName = {};
-	// SourceUnits to search & replace symbol in
-	std::set<frontend::SourceUnit const*, frontend::ASTNode::CompareByID> m_sourceUnits = {};
 	// Source locations that need to be replaced
 	std::vector<langutil::SourceLocation> m_locations = {};
 };
@@ -136,6 +136,7 @@ void Transport::send(Json::Value _json, MessageID _id)
 	// Trailing CRLF only for easier readability.
 	std::string const jsonString = solidity::util::jsonCompactPrint(_json);
 
+	std::lock_guard<std::mutex> lock(m_sendMutex);
 	writeBytes(fmt::format("Content-Length: {}\r\n\r\n", jsonString.size()));
 	writeBytes(jsonString);
 	flushOutput();
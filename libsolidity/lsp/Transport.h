@@ -21,9 +21,11 @@
 
 #include <json/value.h>
 
+#include <atomic>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -111,7 +113,9 @@ public:
 	void setTrace(TraceValue _value) noexcept { m_logTrace = _value; }
 
 private:
-	TraceValue m_logTrace = TraceValue::Off;
+	std::atomic<TraceValue> m_logTrace = TraceValue::Off;
+	/// Serializes the messages sent from different threads.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
@@ -83,6 +83,18 @@ std::optional<SourceLocation> declarationLocation(Declaration const* _declaratio
 	return std::nullopt;
 }
 
+CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _functionCall)
+{
+	if (
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		functionType && functionType->hasDeclaration()
+	)
+		if (auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
+			return functionDefinition;
+
+	return nullptr;
+}
+
 std::optional<SourceLocation> parsePosition(
 	FileRepository const& _fileRepository,
 	std::string const& _sourceUnitName,
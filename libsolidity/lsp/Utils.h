@@ -83,4 +83,8 @@ frontend::Declaration const* referencedDeclaration(frontend::Expression const* _
 /// declaration otherwise. If the input declaration is nullptr, std::nullopt is returned instead.
 std::optional<langutil::SourceLocation> declarationLocation(frontend::Declaration const* _declaration);
 
+/// @returns the function definition called by the given function call, if it is known,
+/// or nullptr otherwise.
+frontend::CallableDeclaration const* extractCallableDeclaration(frontend::FunctionCall const& _functionCall);
+
 }
@@ -22,6 +22,7 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -140,6 +141,83 @@ std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 	return result;
 }
 
+void JsonStreamWriter::beginObject()
+{
+	assertThrow(m_objects.empty(), Exception, "Top-level object started twice.");
+	m_stream << "{";
+	m_objects.push_back({});
+}
+
+void JsonStreamWriter::beginObject(std::string const& _key)
+{
+	assertThrow(!m_objects.empty(), Exception, "Member written outside of an object.");
+	m_objects.push_back({_key, false});
+}
+
+void JsonStreamWriter::member(std::string const& _key, Json::Value const& _value)
+{
+	printedMember(_key, jsonPrint(_value, m_format));
+}
+
+void JsonStreamWriter::printedMember(std::string const& _key, std::string _printedValue)
+{
+	assertThrow(!m_objects.empty(), Exception, "Member written outside of an object.");
+	writePendingObjects();
+	// Like jsoncpp, start non-empty objects and arrays that span multiple lines on a new line.
+	bool multiLine = _printedValue.find('\n') != std::string::npos;
+	if (multiLine)
+		boost::replace_all(_printedValue, "\n", lineStart(depth()));
+	writeKey(depth() - 1, _key, multiLine);
+	m_stream << _printedValue;
+}
+
+void JsonStreamWriter::endObject()
+{
+	assertThrow(!m_objects.empty(), Exception, "No object to end.");
+	if (m_objects.back().pendingKey)
+	{
+		std::string key = std::move(*m_objects.back().pendingKey);
+		m_objects.pop_back();
+		writePendingObjects();
+		writeKey(depth() - 1, key, false);
+		m_stream << "{}";
+		return;
+	}
+	bool hasMembers = m_objects.back().hasMembers;
+	m_objects.pop_back();
+	if (hasMembers)
+		m_stream << lineStart(depth());
+	m_stream << "}";
+}
+
+void JsonStreamWriter::writePendingObjects()
+{
+	for (size_t i = 1; i < m_objects.size(); ++i)
+		if (m_objects[i].pendingKey)
+		{
+			writeKey(i - 1, *m_objects[i].pendingKey, true);
+			m_stream << "{";
+			m_objects[i].pendingKey.reset();
+		}
+}
+
+void JsonStreamWriter::writeKey(size_t _depth, std::string const& _key, bool _valueOnNewLine)
+{
+	if (m_objects[_depth].hasMembers)
+		m_stream << ",";
+	m_objects[_depth].hasMembers = true;
+	m_stream << lineStart(_depth + 1) << jsonCompactPrint(_key) << ":";
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << (_valueOnNewLine ? lineStart(_depth + 1) : " ");
+}
+
+std::string JsonStreamWriter::lineStart(size_t _depth) const
+{
+	if (m_format.format != JsonFormat::Pretty)
+		return {};
+	return "\n" + std::string(_depth * m_format.indent, ' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
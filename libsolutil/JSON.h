@@ -25,8 +25,10 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <optional>
 
 namespace solidity::util
@@ -62,6 +64,52 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+/// Writes a JSON object to a stream member by member, so that it never has to be kept in memory as a whole.
+/// The output is identical to that of jsonPrint() for the complete object, provided that the members of
+/// each object are written in the order of their keys.
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format): m_stream(_stream), m_format(_format) {}
+
+	/// Starts the top-level object.
+	void beginObject();
+	/// Starts an object as the member @a _key of the current object.
+	void beginObject(std::string const& _key);
+	/// Writes @a _value as the member @a _key of the current object.
+	void member(std::string const& _key, Json::Value const& _value);
+	/// Writes the member @a _key of the current object, whose value @a _printedValue has
+	/// already been printed with jsonPrint() in the format of this writer.
+	void printedMember(std::string const& _key, std::string _printedValue);
+	/// Ends the current object.
+	void endObject();
+
+	/// @returns the number of objects that have been started but not ended.
+	size_t depth() const { return m_objects.size(); }
+	/// @returns the format members are printed in.
+	JsonFormat const& format() const { return m_format; }
+
+private:
+	struct Object
+	{
+		/// Key of an object that has been started but not written yet, because whether it is written
+		/// on one line depends on whether it gets members.
+		std::optional<std::string> pendingKey;
+		bool hasMembers = false;
+	};
+
+	/// Writes the keys and opening braces of all pending objects.
+	void writePendingObjects();
+	/// Writes the separator, key and colon of a new member of the object at nesting level @a _depth.
+	void writeKey(size_t _depth, std::string const& _key, bool _valueOnNewLine);
+	/// @returns the line break and indentation of a line at nesting level @a _depth, empty for compact output.
+	std::string lineStart(size_t _depth) const;
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	std::vector<Object> m_objects;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <utility>
+
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _workerCount)
+{
+	for (size_t i = 0; i < _workerCount; ++i)
+		m_workers.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wakeWorkers.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::forEach(size_t _count, std::function<void(size_t)> const& _task)
+{
+	if (m_workers.empty() || _count <= 1)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			_task(index);
+		return;
+	}
+
+	std::lock_guard callLock(m_callMutex);
+	{
+		std::lock_guard lock(m_mutex);
+		m_task = &_task;
+		m_count = _count;
+		m_nextIndex = 0;
+		m_busyWorkers = m_workers.size();
+		m_exception = nullptr;
+		++m_generation;
+	}
+	m_wakeWorkers.notify_all();
+	processTasks();
+
+	std::unique_lock lock(m_mutex);
+	m_workersDone.wait(lock, [&]() { return m_busyWorkers == 0; });
+	m_task = nullptr;
+	if (std::exception_ptr exception = std::exchange(m_exception, nullptr))
+		std::rethrow_exception(exception);
+}
+
+void ThreadPool::workerLoop()
+{
+	uint64_t processedGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_wakeWorkers.wait(lock, [&]() { return m_stopping || m_generation != processedGeneration; });
+			if (m_stopping)
+				return;
+			processedGeneration = m_generation;
+		}
+		processTasks();
+		{
+			std::lock_guard lock(m_mutex);
+			if (--m_busyWorkers == 0)
+				m_workersDone.notify_all();
+		}
+	}
+}
+
+void ThreadPool::processTasks()
+{
+	while (true)
+	{
+		size_t index = 0;
+		{
+			std::lock_guard lock(m_mutex);
+			if (m_nextIndex >= m_count || m_exception)
+				return;
+			index = m_nextIndex++;
+		}
+		try
+		{
+			(*m_task)(index);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(m_mutex);
+			if (!m_exception)
+				m_exception = std::current_exception();
+		}
+	}
+}
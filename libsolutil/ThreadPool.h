@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed set of worker threads that can be reused for independent tasks.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Worker threads that are started once and then process the tasks of any number of forEach()
+ * calls, so that the cost of starting threads is not paid again for every batch of tasks.
+ */
+class ThreadPool
+{
+public:
+	/// Starts @a _workerCount worker threads. Without workers, all tasks run on the calling thread.
+	explicit ThreadPool(size_t _workerCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Calls @a _task for each index in [0, _count), distributed over the workers and the calling
+	/// thread, and returns once all calls have finished. The tasks must not depend on each other.
+	/// If a task throws, the remaining indices are skipped and the first exception is rethrown.
+	/// Concurrent calls are processed one after the other.
+	void forEach(size_t _count, std::function<void(size_t)> const& _task);
+
+	size_t workerCount() const { return m_workers.size(); }
+
+private:
+	void workerLoop();
+	/// Runs tasks of the current forEach() call until there are none left.
+	void processTasks();
+
+	std::vector<std::thread> m_workers;
+	/// Held for the whole duration of a forEach() call.
+	std::mutex m_callMutex;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeWorkers;
+	std::condition_variable m_workersDone;
+	/// Incremented for each forEach() call, so that workers can tell a new batch of tasks.
+	uint64_t m_generation = 0;
+	bool m_stopping = false;
+	std::function<void(size_t)> const* m_task = nullptr;
+	size_t m_count = 0;
+	size_t m_nextIndex = 0;
+	/// Number of workers that have not finished the current forEach() call yet.
+	size_t m_busyWorkers = 0;
+	std::exception_ptr m_exception;
+};
+
+}
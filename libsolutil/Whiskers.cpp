@@ -26,14 +26,283 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' ||
+		_c == '$' ||
+		_c == '-';
+}
+
+/// @returns the length of the run of parameter name characters starting at @a _position.
+size_t parameterLength(std::string_view _text, size_t _position)
+{
+	size_t end = _position;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	return end - _position;
+}
+
+}
+
+struct Whiskers::Template
+{
+	struct Node;
+
+	/// Sequence of text and tags, i.e. the whole template or the body of a list or condition.
+	struct Sequence
+	{
+		/// The text the sequence was parsed from, used in error messages.
+		std::string_view source;
+		std::vector<Node> nodes;
+	};
+
+	enum class NodeKind { Text, Value, List, Condition, NonEmptyCondition };
+
+	struct Node
+	{
+		NodeKind kind;
+		/// The text of text nodes.
+		std::string_view text;
+		/// The parameter name of all other nodes, without the '+' of a condition on a value.
+		std::string name;
+		/// The body of a list or the part of a condition used if it is true.
+		Sequence body;
+		/// The part of a condition used if it is false.
+		Sequence elseBody;
+	};
+
+	explicit Template(std::string _source);
+	Template(Template const&) = delete;
+	Template& operator=(Template const&) = delete;
+
+	/// Splits @a _text into text and tags. At every '<', the first element that is complete
+	/// is taken, and the body of a list or condition extends to the first matching closing tag.
+	/// Incomplete elements are text.
+	static Sequence parse(std::string_view _text);
+	/// @returns the element starting with the '<' at @a _position together with the position
+	/// following it, or nullopt if it is not the start of a complete element.
+	static std::optional<std::pair<Node, size_t>> parseElement(std::string_view _text, size_t _position);
+
+	/// Appends the expansion of @a _sequence to @a _output. @a _listElement, if given,
+	/// holds the values of the current list element, which are visible in addition
+	/// to @a _parameters.
+	static void render(
+		Sequence const& _sequence,
+		StringMap const& _parameters,
+		StringMap const* _listElement,
+		std::map<std::string, bool> const& _conditions,
+		StringListMap const& _listParameters,
+		std::string& _output
+	);
+
+	std::string const source;
+	Sequence const root;
+	/// The text between '<' and '>' of all tags that consist of an optional '?', '#' or '/'
+	/// followed by a parameter name.
+	std::set<std::string, std::less<>> tags;
+};
+
+Whiskers::Template::Template(std::string _source):
+	source(std::move(_source)),
+	root(parse(source))
+{
+	for (size_t position = source.find('<'); position != std::string::npos; position = source.find('<', position + 1))
+	{
+		size_t nameStart = position + 1;
+		if (nameStart < source.size() && (source[nameStart] == '?' || source[nameStart] == '#' || source[nameStart] == '/'))
+			++nameStart;
+		size_t const tagEnd = nameStart + parameterLength(source, nameStart);
+		if (tagEnd > nameStart && tagEnd < source.size() && source[tagEnd] == '>')
+			tags.emplace(source.substr(position + 1, tagEnd - position - 1));
+	}
+}
+
+Whiskers::Template::Sequence Whiskers::Template::parse(std::string_view _text)
+{
+	Sequence sequence{_text, {}};
+	size_t textStart = 0;
+	size_t position = _text.find('<');
+	while (position != std::string_view::npos)
+	{
+		if (auto element = parseElement(_text, position))
+		{
+			if (position > textStart)
+				sequence.nodes.push_back(Node{NodeKind::Text, _text.substr(textStart, position - textStart), {}, {}, {}});
+			sequence.nodes.push_back(std::move(element->first));
+			textStart = element->second;
+			position = _text.find('<', textStart);
+		}
+		else
+			position = _text.find('<', position + 1);
+	}
+	if (textStart < _text.size())
+		sequence.nodes.push_back(Node{NodeKind::Text, _text.substr(textStart), {}, {}, {}});
+	return sequence;
+}
+
+std::optional<std::pair<Whiskers::Template::Node, size_t>> Whiskers::Template::parseElement(
+	std::string_view _text,
+	size_t _position
+)
+{
+	size_t nameStart = _position + 1;
+	char const prefix = nameStart < _text.size() ? _text[nameStart] : 0;
+	bool const nonEmptyCondition = prefix == '?' && nameStart + 1 < _text.size() && _text[nameStart + 1] == '+';
+	if (prefix == '#' || prefix == '?')
+		nameStart += nonEmptyCondition ? 2 : 1;
+	size_t const nameLength = parameterLength(_text, nameStart);
+	size_t const tagEnd = nameStart + nameLength;
+	if (nameLength == 0 || tagEnd >= _text.size() || _text[tagEnd] != '>')
+		return std::nullopt;
+
+	std::string name{_text.substr(nameStart, nameLength)};
+	if (prefix != '#' && prefix != '?')
+		return std::make_pair(Node{NodeKind::Value, {}, std::move(name), {}, {}}, tagEnd + 1);
+
+	// Closing and else tags repeat the opening tag after its prefix, including a '+'.
+	std::string const tagName{_text.substr(_position + 2, tagEnd - _position - 2)};
+	std::string const closingTag = "</" + tagName + ">";
+	size_t const bodyStart = tagEnd + 1;
+	size_t const closingPosition = _text.find(closingTag, bodyStart);
+	if (closingPosition == std::string_view::npos)
+		return std::nullopt;
+	size_t const end = closingPosition + closingTag.size();
+
+	if (prefix == '#')
+		return std::make_pair(
+			Node{NodeKind::List, {}, std::move(name), parse(_text.substr(bodyStart, closingPosition - bodyStart)), {}},
+			end
+		);
+
+	std::string const elseTag = "<!" + tagName + ">";
+	size_t const elsePosition = _text.substr(0, closingPosition).find(elseTag, bodyStart);
+	size_t const bodyEnd = elsePosition == std::string_view::npos ? closingPosition : elsePosition;
+	Node node{
+		nonEmptyCondition ? NodeKind::NonEmptyCondition : NodeKind::Condition,
+		{},
+		std::move(name),
+		parse(_text.substr(bodyStart, bodyEnd - bodyStart)),
+		{}
+	};
+	if (elsePosition != std::string_view::npos)
+	{
+		size_t const elseStart = elsePosition + elseTag.size();
+		node.elseBody = parse(_text.substr(elseStart, closingPosition - elseStart));
+	}
+	return std::make_pair(std::move(node), end);
+}
+
+void Whiskers::Template::render(
+	Sequence const& _sequence,
+	StringMap const& _parameters,
+	StringMap const* _listElement,
+	std::map<std::string, bool> const& _conditions,
+	StringListMap const& _listParameters,
+	std::string& _output
+)
+{
+	auto findValue = [&](std::string const& _name) -> std::string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Node const& node: _sequence.nodes)
+		switch (node.kind)
+		{
+		case NodeKind::Text:
+			_output += node.text;
+			break;
+		case NodeKind::Value:
+		{
+			std::string const* value = findValue(node.name);
+			assertThrow(
+				value,
+				WhiskersError,
+				"Value for tag " + node.name + " not provided.\n" +
+				"Template:\n" +
+				std::string(_sequence.source)
+			);
+			_output += *value;
+			break;
+		}
+		case NodeKind::List:
+		{
+			auto list = _listParameters.find(node.name);
+			assertThrow(
+				list != _listParameters.end(),
+				WhiskersError, "List parameter " + node.name + " not set."
+			);
+			// Lists cannot contain lists, so list elements only see list parameters of other lists.
+			static StringListMap const noListParameters;
+			for (StringMap const& element: list->second)
+			{
+				for (auto const& value: element)
+					assertThrow(
+						!_parameters.count(value.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(node.body, _parameters, &element, _conditions, noListParameters, _output);
+			}
+			break;
+		}
+		case NodeKind::Condition:
+		case NodeKind::NonEmptyCondition:
+		{
+			bool conditionValue = false;
+			if (node.kind == NodeKind::NonEmptyCondition)
+			{
+				if (std::string const* value = findValue(node.name))
+					conditionValue = !value->empty();
+				else if (auto list = _listParameters.find(node.name); list != _listParameters.end())
+					conditionValue = !list->second.empty();
+				else
+					assertThrow(false, WhiskersError, "Tag " + node.name + " used as condition but was not set.");
+			}
+			else
+			{
+				auto condition = _conditions.find(node.name);
+				assertThrow(
+					condition != _conditions.end(),
+					WhiskersError, "Condition parameter " + node.name + " not set."
+				);
+				conditionValue = condition->second;
+			}
+			render(
+				conditionValue ? node.body : node.elseBody,
+				_parameters,
+				_listElement,
+				_conditions,
+				_listParameters,
+				_output
+			);
+			break;
+		}
+		}
+}
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(compile(std::move(_template)))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(std::string _parameter, std::string _value)
@@ -71,25 +340,63 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	std::string result;
+	result.reserve(m_template->source.size());
+	Template::render(m_template->root, m_parameters, nullptr, m_conditions, m_listParameters, result);
+	return result;
 }
 
-void Whiskers::checkTemplateValid() const
+std::shared_ptr<Whiskers::Template const> Whiskers::compile(std::string _template)
 {
-	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	std::smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
-	);
+	// Templates assembled at runtime could make the cache grow without bound.
+	static size_t constexpr maxCachedTemplates = 4096;
+	static std::mutex mutex;
+	static std::unordered_map<std::string_view, std::shared_ptr<Template const>> cache;
+
+	{
+		std::lock_guard lock(mutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+
+	checkTemplateValid(_template);
+	auto compiled = std::make_shared<Template const>(std::move(_template));
+
+	std::lock_guard lock(mutex);
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	// The key refers to the text owned by the template.
+	return cache.emplace(compiled->source, compiled).first->second;
+}
+
+void Whiskers::checkTemplateValid(std::string_view _template)
+{
+	// Rejects '<' followed by '#', '?', '!' or '/', an optional '+' and a parameter name
+	// that is not terminated by '>'.
+	for (size_t position = _template.find('<'); position != std::string_view::npos; position = _template.find('<', position + 1))
+	{
+		if (position + 1 >= _template.size() || std::string_view("#?!/").find(_template[position + 1]) == std::string_view::npos)
+			continue;
+		size_t nameStart = position + 2;
+		if (nameStart < _template.size() && _template[nameStart] == '+')
+			++nameStart;
+		size_t const nameLength = parameterLength(_template, nameStart);
+		size_t const tagEnd = nameStart + nameLength;
+		if (nameLength == 0 || (tagEnd < _template.size() && _template[tagEnd] == '>'))
+			continue;
+		assertThrow(
+			false,
+			WhiskersError,
+			"Template contains an invalid/unclosed tag " +
+			std::string(_template.substr(position, std::min(tagEnd + 1, _template.size()) - position))
+		);
+	}
 }
 
 void Whiskers::checkParameterValid(std::string const& _parameter) const
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && std::all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -117,127 +424,9 @@ void Whiskers::checkParameterUnknown(std::string const& _parameter) const
 void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const
 {
 	for (auto const& prefix: _prefixes)
-	{
-		std::string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != std::string::npos,
+			m_template->tags.count(prefix + _parameter),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '<" + prefix + _parameter + ">' not found in template:\n" + m_template->source
 		);
-	}
 }
-
-namespace
-{
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
-{
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
-std::string Whiskers::replace(
-	std::string const& _template,
-	StringMap const& _parameters,
-	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
-)
-{
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
-	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			std::string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				std::string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
@@ -147,7 +147,10 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
+	std::optional<size_t> expectedExecutionsPerDeployment;
+	if (m_optimiserSettings.splitLargeSwitches)
+		expectedExecutionsPerDeployment = m_optimiserSettings.expectedExecutionsPerDeployment;
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion, expectedExecutionsPerDeployment);
 }
 
 void YulStack::optimize(Object& _object, bool _isCreation)
@@ -24,6 +24,7 @@
 #include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libsolutil/cxx20.h>
 #include <libsolutil/Visitor.h>
@@ -43,6 +44,9 @@
 #include <range/v3/view/take_last.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
+#include <functional>
+
 using namespace solidity;
 using namespace solidity::yul;
 
@@ -208,14 +212,15 @@ void markNeedsCleanStack(CFG& _cfg)
 std::unique_ptr<CFG> ControlFlowGraphBuilder::build(
 	AsmAnalysisInfo const& _analysisInfo,
 	Dialect const& _dialect,
-	Block const& _block
+	Block const& _block,
+	GasMeter const* _gasMeter
 )
 {
 	auto result = std::make_unique<CFG>();
 	result->entry = &result->makeBlock(debugDataOf(_block));
 
 	ControlFlowSideEffectsCollector sideEffects(_dialect, _block);
-	ControlFlowGraphBuilder builder(*result, _analysisInfo, sideEffects.functionSideEffects(), _dialect);
+	ControlFlowGraphBuilder builder(*result, _analysisInfo, sideEffects.functionSideEffects(), _dialect, _gasMeter);
 	builder.m_currentBlock = result->entry;
 	builder(_block);
 
@@ -234,12 +239,14 @@ ControlFlowGraphBuilder::ControlFlowGraphBuilder(
 	CFG& _graph,
 	AsmAnalysisInfo const& _analysisInfo,
 	std::map<FunctionDefinition const*, ControlFlowSideEffects> const& _functionSideEffects,
-	Dialect const& _dialect
+	Dialect const& _dialect,
+	GasMeter const* _gasMeter
 ):
 	m_graph(_graph),
 	m_info(_analysisInfo),
 	m_functionSideEffects(_functionSideEffects),
-	m_dialect(_dialect)
+	m_dialect(_dialect),
+	m_gasMeter(_gasMeter)
 {
 }
 
@@ -369,6 +376,77 @@ void ControlFlowGraphBuilder::operator()(Switch const& _switch)
 	};
 	CFG::BasicBlock& afterSwitch = m_graph.makeBlock(preSwitchDebugData);
 	yulAssert(!_switch.cases.empty(), "");
+
+	std::vector<Case const*> valueCases;
+	for (auto const& switchCase: _switch.cases)
+		if (switchCase.value)
+			valueCases.emplace_back(&switchCase);
+	BuiltinFunction const* lessThanBuiltin = m_dialect.builtin("lt"_yulstring);
+	if (lessThanBuiltin && splitSwitch(valueCases.size()))
+	{
+		std::stable_sort(valueCases.begin(), valueCases.end(), [](Case const* _lhs, Case const* _rhs) {
+			return valueOfLiteral(*_lhs->value) < valueOfLiteral(*_rhs->value);
+		});
+		std::map<Case const*, CFG::BasicBlock*> caseBranches;
+		for (auto const& switchCase: _switch.cases)
+			caseBranches[&switchCase] = &m_graph.makeBlock(debugDataOf(switchCase.body));
+		Case const& lastCase = _switch.cases.back();
+		CFG::BasicBlock& defaultBranch = lastCase.value ? afterSwitch : *caseBranches.at(&lastCase);
+
+		// Artificially generate:
+		// lt(<ghostVariable>, <literal>)
+		auto makeLessThanCompare = [&](Case const& _case) {
+			yul::FunctionCall const& ghostCall = m_graph.ghostCalls.emplace_back(yul::FunctionCall{
+				debugDataOf(_case),
+				yul::Identifier{{}, "lt"_yulstring},
+				{Identifier{{}, ghostVariableName}, *_case.value}
+			});
+			CFG::Operation& operation = m_currentBlock->operations.emplace_back(CFG::Operation{
+				Stack{LiteralSlot{valueOfLiteral(*_case.value), debugDataOf(*_case.value)}, ghostVarSlot},
+				Stack{TemporarySlot{ghostCall, 0}},
+				CFG::BuiltinCall{debugDataOf(_case), *lessThanBuiltin, ghostCall, 2},
+			});
+			return operation.output.front();
+		};
+		// Selects among the sorted cases in [_begin, _end) by bisecting on the case values
+		// for as long as this is deemed beneficial and by comparing for equality afterwards.
+		std::function<void(size_t, size_t)> select = [&](size_t _begin, size_t _end) {
+			if (splitSwitch(_end - _begin))
+			{
+				size_t middle = _begin + (_end - _begin) / 2;
+				auto& lowerHalf = m_graph.makeBlock(debugDataOf(_switch));
+				auto& upperHalf = m_graph.makeBlock(debugDataOf(_switch));
+				makeConditionalJump(debugDataOf(*valueCases[middle]), makeLessThanCompare(*valueCases[middle]), lowerHalf, upperHalf);
+				m_currentBlock = &lowerHalf;
+				select(_begin, middle);
+				m_currentBlock = &upperHalf;
+				select(middle, _end);
+				return;
+			}
+			for (size_t index = _begin; index < _end; ++index)
+			{
+				Case const& switchCase = *valueCases[index];
+				if (index + 1 == _end)
+					makeConditionalJump(debugDataOf(switchCase), makeValueCompare(switchCase), *caseBranches.at(&switchCase), defaultBranch);
+				else
+				{
+					auto& elseBranch = m_graph.makeBlock(debugDataOf(_switch));
+					makeConditionalJump(debugDataOf(switchCase), makeValueCompare(switchCase), *caseBranches.at(&switchCase), elseBranch);
+					m_currentBlock = &elseBranch;
+				}
+			}
+		};
+		select(0, valueCases.size());
+
+		for (auto const& switchCase: _switch.cases)
+		{
+			m_currentBlock = caseBranches.at(&switchCase);
+			(*this)(switchCase.body);
+			jump(debugDataOf(switchCase.body), afterSwitch);
+		}
+		return;
+	}
+
 	for (auto const& switchCase: _switch.cases | ranges::views::drop_last(1))
 	{
 		yulAssert(switchCase.value, "");
@@ -391,6 +469,29 @@ void ControlFlowGraphBuilder::operator()(Switch const& _switch)
 	jump(debugDataOf(switchCase.body), afterSwitch);
 }
 
+bool ControlFlowGraphBuilder::splitSwitch(size_t _numberOfCases) const
+{
+	if (!m_gasMeter || _numberOfCases <= 4)
+		return false;
+
+	using evmasm::Instruction;
+	bigint compareRunCosts = 0;
+	bigint compareDataCosts = 0;
+	for (Instruction instruction: {Instruction::DUP1, Instruction::PUSH1, Instruction::EQ, Instruction::PUSH2, Instruction::JUMPI})
+	{
+		auto [runCosts, dataCosts] = m_gasMeter->instructionRunAndDataCosts(instruction);
+		compareRunCosts += runCosts;
+		compareDataCosts += dataCosts;
+	}
+	// Splitting adds one comparison and a jump to the upper half.
+	bigint splitDataCosts = compareDataCosts;
+	for (Instruction instruction: {Instruction::JUMPDEST, Instruction::PUSH2, Instruction::JUMP})
+		splitDataCosts += m_gasMeter->instructionRunAndDataCosts(instruction).second;
+	// On average, splitting saves a quarter of the comparisons, while the remaining
+	// linear sequences are kept at a minimum length of four cases.
+	return compareRunCosts * (_numberOfCases - 4) > 4 * splitDataCosts;
+}
+
 void ControlFlowGraphBuilder::operator()(ForLoop const& _loop)
 {
 	langutil::DebugData::ConstPtr preLoopDebugData = debugDataOf(_loop);
@@ -468,7 +569,7 @@ void ControlFlowGraphBuilder::operator()(FunctionDefinition const& _function)
 
 	CFG::FunctionInfo& functionInfo = m_graph.functionInfo.at(&function);
 
-	ControlFlowGraphBuilder builder{m_graph, m_info, m_functionSideEffects, m_dialect};
+	ControlFlowGraphBuilder builder{m_graph, m_info, m_functionSideEffects, m_dialect, m_gasMeter};
 	builder.m_currentFunction = &functionInfo;
 	builder.m_currentBlock = functionInfo.entry;
 	builder(_function.body);
@@ -26,12 +26,22 @@
 namespace solidity::yul
 {
 
+class GasMeter;
+
 class ControlFlowGraphBuilder
 {
 public:
 	ControlFlowGraphBuilder(ControlFlowGraphBuilder const&) = delete;
 	ControlFlowGraphBuilder& operator=(ControlFlowGraphBuilder const&) = delete;
-	static std::unique_ptr<CFG> build(AsmAnalysisInfo const& _analysisInfo, Dialect const& _dialect, Block const& _block);
+	/// If @a _gasMeter is given, large switch statements may be lowered to a binary search
+	/// over their case values instead of a linear sequence of comparisons, if the gas meter
+	/// deems this to be beneficial.
+	static std::unique_ptr<CFG> build(
+		AsmAnalysisInfo const& _analysisInfo,
+		Dialect const& _dialect,
+		Block const& _block,
+		GasMeter const* _gasMeter = nullptr
+	);
 
 	StackSlot operator()(Expression const& _literal);
 	StackSlot operator()(Literal const& _literal);
@@ -57,12 +67,17 @@ private:
 		CFG& _graph,
 		AsmAnalysisInfo const& _analysisInfo,
 		std::map<FunctionDefinition const*, ControlFlowSideEffects> const& _functionSideEffects,
-		Dialect const& _dialect
+		Dialect const& _dialect,
+		GasMeter const* _gasMeter
 	);
 	void registerFunction(FunctionDefinition const& _function);
 	Stack const& visitFunctionCall(FunctionCall const&);
 	Stack visitAssignmentRightHandSide(Expression const& _expression, size_t _expectedSlotCount);
 
+	/// @returns true if a switch with @a _numberOfCases non-default cases should be split
+	/// into two halves by a comparison with the median case value.
+	bool splitSwitch(size_t _numberOfCases) const;
+
 	Scope::Function const& lookupFunction(YulString _name) const;
 	Scope::Variable const& lookupVariable(YulString _name) const;
 	/// Resets m_currentBlock to enforce a subsequent explicit reassignment.
@@ -81,6 +96,7 @@ private:
 	AsmAnalysisInfo const& m_info;
 	std::map<FunctionDefinition const*, ControlFlowSideEffects> const& m_functionSideEffects;
 	Dialect const& m_dialect;
+	GasMeter const* m_gasMeter = nullptr;
 	CFG::BasicBlock* m_currentBlock = nullptr;
 	Scope* m_scope = nullptr;
 	struct ForLoopInfo
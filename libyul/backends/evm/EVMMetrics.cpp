@@ -45,6 +45,12 @@ bigint GasMeter::instructionCosts(evmasm::Instruction _instruction) const
 	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
 }
 
+std::pair<bigint, bigint> GasMeter::instructionRunAndDataCosts(evmasm::Instruction _instruction) const
+{
+	auto [runGas, dataGas] = GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation);
+	return {runGas * m_runs, dataGas};
+}
+
 bigint GasMeter::combineCosts(std::pair<bigint, bigint> _costs) const
 {
 	return _costs.first * m_runs + _costs.second;
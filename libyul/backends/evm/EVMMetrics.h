@@ -54,6 +54,9 @@ public:
 	/// @returns the combined costs of deploying and running the instruction, not including
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
+	/// @returns the costs of running the instruction (multiplied by the number of runs) and the
+	/// costs of deploying it separately, not including the costs for its arguments.
+	std::pair<bigint, bigint> instructionRunAndDataCosts(evmasm::Instruction _instruction) const;
 
 private:
 	bigint combineCosts(std::pair<bigint, bigint> _costs) const;
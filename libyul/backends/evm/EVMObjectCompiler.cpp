@@ -23,6 +23,7 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
 
 #include <libyul/optimiser/FunctionCallFinder.h>
@@ -39,10 +40,11 @@ void EVMObjectCompiler::compile(
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	std::optional<size_t> _expectedExecutionsPerDeployment
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion, _expectedExecutionsPerDeployment);
 	compiler.run(_object, _optimize);
 }
 
@@ -59,7 +61,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion, m_expectedExecutionsPerDeployment);
 		}
 		else
 		{
@@ -80,13 +82,21 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 		);
 	if (_optimize && m_dialect.evmVersion().canOverchargeGasForCall())
 	{
+		std::unique_ptr<GasMeter> meter;
+		if (m_expectedExecutionsPerDeployment)
+			meter = std::make_unique<GasMeter>(
+				m_dialect,
+				!boost::ends_with(_object.name.str(), "_deployed"),
+				*m_expectedExecutionsPerDeployment
+			);
 		auto stackErrors = OptimizedEVMCodeTransform::run(
 			m_assembly,
 			*_object.analysisInfo,
 			*_object.code,
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			meter.get()
 		);
 		if (!stackErrors.empty())
 		{
@@ -39,6 +39,7 @@ namespace solidity::yul
 {
 struct AsmAnalysisInfo;
 struct StackLayout;
+class GasMeter;
 
 class OptimizedEVMCodeTransform
 {
@@ -47,13 +48,16 @@ public:
 	/// 2) For none of the functions 3) for the first function of each name.
 	enum class UseNamedLabels { YesAndForceUnique, Never, ForFirstFunctionOfEachName };
 
+	/// If @a _gasMeter is given, it is used to decide whether large switch statements are lowered
+	/// to a binary search over their case values (see ControlFlowGraphBuilder::build).
 	[[nodiscard]] static std::vector<StackTooDeepError> run(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		GasMeter const* _gasMeter = nullptr
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
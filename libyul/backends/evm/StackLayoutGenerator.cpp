@@ -23,10 +23,14 @@
 
 #include <libyul/backends/evm/StackHelpers.h>
 
+#include <libyul/AsmPrinter.h>
+
 #include <libevmasm/GasMeter.h>
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -47,14 +51,34 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, util::ThreadPool* _threadPool)
 {
-	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout, nullptr}.processEntryPoint(*_cfg.entry);
-
-	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout, &functionInfo}.processEntryPoint(*functionInfo.entry, &functionInfo);
+	// The subgraphs of the main entry point and of all functions are disjoint and the layout of each of
+	// them only depends on its own blocks, so they can be processed concurrently into separate layouts.
+	std::vector<CFG::FunctionInfo const*> entryPoints{nullptr};
+	for (auto const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		entryPoints.emplace_back(&functionInfo);
+	std::vector<StackLayout> layouts(entryPoints.size());
+
+	auto const processEntryPoint = [&](size_t _index) {
+		CFG::FunctionInfo const* functionInfo = entryPoints[_index];
+		StackLayoutGenerator{layouts[_index], functionInfo}.processEntryPoint(
+			functionInfo ? *functionInfo->entry : *_cfg.entry,
+			functionInfo
+		);
+	};
+	if (_threadPool)
+		_threadPool->forEach(entryPoints.size(), processEntryPoint);
+	else
+		for (size_t index = 0; index < entryPoints.size(); ++index)
+			processEntryPoint(index);
 
+	StackLayout stackLayout;
+	for (StackLayout& layout: layouts)
+	{
+		stackLayout.blockInfos.merge(layout.blockInfos);
+		stackLayout.operationEntryLayout.merge(layout.operationEntryLayout);
+	}
 	return stackLayout;
 }
 
@@ -88,6 +112,53 @@ std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStac
 	return generator.reportStackTooDeep(*entry);
 }
 
+std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(
+	CFG const& _cfg,
+	Block const& _block,
+	StackTooDeepCache& _cache
+)
+{
+	// The layout of a function only depends on its own code and on the number of arguments and
+	// return values of the functions it calls and whether they can continue.
+	// The function infos are keyed by pointer, so sort them by name for a deterministic key.
+	std::vector<std::string> signatures;
+	for (auto const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		signatures.emplace_back(
+			functionInfo.function.name.str() + ":" +
+			std::to_string(functionInfo.parameters.size()) + ":" +
+			std::to_string(functionInfo.returnVariables.size()) + ":" +
+			(functionInfo.canContinue ? "1" : "0") + "\n"
+		);
+	std::sort(signatures.begin(), signatures.end());
+	std::string functionSignatures;
+	for (std::string const& signature: signatures)
+		functionSignatures += signature;
+
+	AsmPrinter printer{nullptr, std::nullopt, langutil::DebugInfoSelection::None()};
+	auto const lookup = [&](YulString _functionName, std::string const& _code) -> std::vector<StackTooDeep> const& {
+		util::h256 key = util::keccak256(functionSignatures + _functionName.str() + "\n" + _code);
+		auto it = _cache.find(key);
+		if (it == _cache.end())
+			it = _cache.emplace(key, reportStackTooDeep(_cfg, _functionName)).first;
+		return it->second;
+	};
+
+	std::string mainCode;
+	for (auto const& statement: _block.statements)
+		if (!std::holds_alternative<FunctionDefinition>(statement))
+			mainCode += std::visit(printer, statement) + "\n";
+
+	std::map<YulString, std::vector<StackTooDeep>> stackTooDeepErrors;
+	stackTooDeepErrors[YulString{}] = lookup(YulString{}, mainCode);
+	for (auto const& function: _cfg.functions)
+	{
+		CFG::FunctionInfo const& functionInfo = _cfg.functionInfo.at(function);
+		if (auto const& errors = lookup(function->name, printer(functionInfo.functionDefinition)); !errors.empty())
+			stackTooDeepErrors[function->name] = errors;
+	}
+	return stackTooDeepErrors;
+}
+
 StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, CFG::FunctionInfo const* _functionInfo):
 	m_layout(_layout),
 	m_currentFunctionInfo(_functionInfo)
@@ -23,8 +23,15 @@
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
 
+#include <libsolutil/FixedHash.h>
+
 #include <map>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -55,7 +62,10 @@ public:
 		std::vector<YulString> variableChoices;
 	};
 
-	static StackLayout run(CFG const& _cfg);
+	/// @returns the stack layouts of the main entry point and of all functions in @a _cfg.
+	/// If @a _threadPool is given, the entry points are processed on its workers, which yields
+	/// the same layout as processing them one after the other.
+	static StackLayout run(CFG const& _cfg, util::ThreadPool* _threadPool = nullptr);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
@@ -65,6 +75,20 @@ public:
 	/// If @a _functionName is empty, the stack too deep errors of the main entry point are reported instead.
 	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName);
 
+	/// Stack too deep errors of individual functions, keyed by a hash of everything the
+	/// stack layout of a function depends on (see ``reportStackTooDeep`` below).
+	using StackTooDeepCache = std::map<util::h256, std::vector<StackTooDeep>>;
+	/// Same as ``reportStackTooDeep(_cfg)``, but looks up the errors of each function in @a _cache first
+	/// and only generates the layout of functions that are not found.
+	/// Functions are keyed by their code and the signatures and control flow side effects of all functions
+	/// in @a _cfg, so that the cache can be shared between analyses of successively modified versions of
+	/// the same object. Requires @a _cfg to be generated from @a _block.
+	static std::map<YulString, std::vector<StackTooDeep>> reportStackTooDeep(
+		CFG const& _cfg,
+		Block const& _block,
+		StackTooDeepCache& _cache
+	);
+
 private:
 	StackLayoutGenerator(StackLayout& _context, CFG::FunctionInfo const* _functionInfo);
 
@@ -239,7 +239,8 @@ bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	StackLayoutGenerator::StackTooDeepCache* _stackTooDeepCache
 )
 {
 	yulAssert(
@@ -261,7 +262,9 @@ bool StackCompressor::run(
 		eliminateVariablesOptimizedCodegen(
 			_dialect,
 			*_object.code,
-			StackLayoutGenerator::reportStackTooDeep(*cfg),
+			_stackTooDeepCache ?
+				StackLayoutGenerator::reportStackTooDeep(*cfg, *_object.code, *_stackTooDeepCache) :
+				StackLayoutGenerator::reportStackTooDeep(*cfg),
 			allowMSizeOptimization
 		);
 	}
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libyul/Object.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
 
 #include <memory>
 
@@ -45,12 +46,15 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// If the optimized code generator is used and @a _stackTooDeepCache is given, the stack
+	/// too deep errors of functions already analysed in a previous run are taken from the cache.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		StackLayoutGenerator::StackTooDeepCache* _stackTooDeepCache = nullptr
 	);
 };
 
@@ -119,7 +119,8 @@ u256 literalArgumentValue(FunctionCall const& _call)
 
 void StackLimitEvader::run(
 	OptimiserStepContext& _context,
-	Object& _object
+	Object& _object,
+	StackLayoutGenerator::StackTooDeepCache* _stackTooDeepCache
 )
 {
 	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
@@ -131,7 +132,10 @@ void StackLimitEvader::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, _object);
 		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, *_object.code);
-		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg));
+		run(_context, _object, _stackTooDeepCache ?
+			StackLayoutGenerator::reportStackTooDeep(*cfg, *_object.code, *_stackTooDeepCache) :
+			StackLayoutGenerator::reportStackTooDeep(*cfg)
+		);
 	}
 	else
 		run(_context, _object, CompilabilityChecker{
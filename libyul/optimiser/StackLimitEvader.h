@@ -77,9 +77,12 @@ public:
 	/// Abort and do nothing, if no ``memoryguard`` call or several ``memoryguard`` calls
 	/// with non-matching arguments are found, or if any of the unreachable variables
 	/// are contained in a recursive function.
+	/// If @a _stackTooDeepCache is given, it is used to look up the stack too deep errors of
+	/// functions that were already analysed, e.g. by the StackCompressor.
 	static void run(
 		OptimiserStepContext& _context,
-		Object& _object
+		Object& _object,
+		StackLayoutGenerator::StackTooDeepCache* _stackTooDeepCache = nullptr
 	);
 };
 
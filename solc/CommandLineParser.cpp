@@ -67,7 +67,10 @@ static std::string const g_strMachine = "machine";
 static std::string const g_strNoCBORMetadata = "no-cbor-metadata";
 static std::string const g_strMetadataHash = "metadata-hash";
 static std::string const g_strMetadataLiteral = "metadata-literal";
+static std::string const g_strModelCheckerBatchTargets = "model-checker-batch-targets";
+static std::string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static std::string const g_strModelCheckerContracts = "model-checker-contracts";
+static std::string const g_strModelCheckerCrossCheckSolvers = "model-checker-cross-check-solvers";
 static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
@@ -76,8 +79,10 @@ static std::string const g_strModelCheckerPrintQuery = "model-checker-print-quer
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
+static std::string const g_strModelCheckerSMTLib2Solver = "model-checker-smtlib2-solver";
 static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
+static std::string const g_strModelCheckerThreads = "model-checker-threads";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
 static std::string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
 static std::string const g_strNone = "none";
@@ -836,6 +841,21 @@ General Information)").c_str(),
 			"Multiple pairs <source>:<contract> can be selected at the same time, separated by a comma "
 			"and no spaces."
 		)
+		(
+			g_strModelCheckerBatchTargets.c_str(),
+			"Check all CHC targets with a single query first and only check smaller groups of targets"
+			" if one of them is reachable."
+		)
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Cache the answers of the solvers in the given directory and reuse them in later runs."
+		)
+		(
+			g_strModelCheckerCrossCheckSolvers.c_str(),
+			"Wait for the answers of all enabled solvers and report conflicting answers"
+			" instead of using the answer of the first solver that answers a query."
+		)
 		(
 			g_strModelCheckerDivModNoSlacks.c_str(),
 			"Encode division and modulo operations with their precise operators"
@@ -875,6 +895,12 @@ General Information)").c_str(),
 			g_strModelCheckerShowUnsupported.c_str(),
 			"Show all unsupported language features separately."
 		)
+		(
+			g_strModelCheckerSMTLib2Solver.c_str(),
+			po::value<std::string>()->value_name("command"),
+			"Command line of an interactive SMT-LIB2 solver, for example \"z3 -in\". "
+			"The smtlib2 solver of BMC keeps it running and sends it its queries incrementally."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<std::string>()->value_name("cvc4,eld,z3,smtlib2")->default_value("z3"),
@@ -887,6 +913,13 @@ General Information)").c_str(),
 			"Multiple targets can be selected at the same time, separated by a comma and no spaces."
 			" By default all targets except underflow and overflow are selected."
 		)
+		(
+			g_strModelCheckerThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Set the number of threads the CHC engine uses to solve the queries of the verification targets."
+			" Only queries to z3 are solved concurrently."
+			" Default is 1."
+		)
 		(
 			g_strModelCheckerTimeout.c_str(),
 			po::value<unsigned>()->value_name("ms"),
@@ -995,7 +1028,10 @@ void CommandLineParser::processArgs()
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerBatchTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCrossCheckSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1003,7 +1039,9 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSMTLib2Solver, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1338,6 +1376,15 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.contracts = std::move(*contracts);
 	}
 
+	if (m_args.count(g_strModelCheckerBatchTargets))
+		m_options.modelChecker.settings.batchTargets = true;
+
+	if (m_args.count(g_strModelCheckerCacheDir))
+		m_options.modelChecker.settings.cacheDirectory = boost::filesystem::path(m_args[g_strModelCheckerCacheDir].as<std::string>());
+
+	if (m_args.count(g_strModelCheckerCrossCheckSolvers))
+		m_options.modelChecker.settings.crossCheckSolvers = true;
+
 	if (m_args.count(g_strModelCheckerDivModNoSlacks))
 		m_options.modelChecker.settings.divModNoSlacks = true;
 
@@ -1377,6 +1424,9 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowUnsupported))
 		m_options.modelChecker.settings.showUnsupported = true;
 
+	if (m_args.count(g_strModelCheckerSMTLib2Solver))
+		m_options.modelChecker.settings.smtlib2Solver = m_args[g_strModelCheckerSMTLib2Solver].as<std::string>();
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		std::string solversStr = m_args[g_strModelCheckerSolvers].as<std::string>();
@@ -1402,6 +1452,14 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.targets = *targets;
 	}
 
+	if (m_args.count(g_strModelCheckerThreads))
+	{
+		unsigned threads = m_args[g_strModelCheckerThreads].as<unsigned>();
+		if (threads == 0)
+			solThrow(CommandLineValidationError, "The model checker needs at least one thread");
+		m_options.modelChecker.settings.threads = threads;
+	}
+
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
@@ -1414,7 +1472,10 @@ void CommandLineParser::processArgs()
 
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerBatchTargets) ||
+		m_args.count(g_strModelCheckerCacheDir) ||
 		m_args.count(g_strModelCheckerContracts) ||
+		m_args.count(g_strModelCheckerCrossCheckSolvers) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
@@ -1422,8 +1483,10 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
+		m_args.count(g_strModelCheckerSMTLib2Solver) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
+		m_args.count(g_strModelCheckerThreads) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+SOLTMPDIR=$(mktemp -d -t "cmdline-test-model-checker-cache-XXXXXX")
+CACHE_DIR="${SOLTMPDIR}/cache"
+
+SOURCE='// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract C {
+    uint x;
+    function f(uint a, uint b) public {
+        x = a / b;
+        assert(a + b >= a);
+        assert(x > 0);
+    }
+}'
+
+function model_checker_output
+{
+    echo "$SOURCE" | msg_on_error "$SOLC" - \
+        --model-checker-engine all \
+        --model-checker-targets all \
+        --model-checker-cache-dir "$CACHE_DIR" 2>&1
+}
+
+# The first run fills the cache, the second one only reads from it.
+uncached_output=$(model_checker_output)
+[[ -n $(ls -A "$CACHE_DIR") ]] || fail "The model checker did not store any answers in $CACHE_DIR."
+cached_output=$(model_checker_output)
+diff_values "$uncached_output" "$cached_output" || fail "The answers from the cache changed the output."
+
+# Malformed answers are treated as missing.
+for entry in "$CACHE_DIR"/*
+do
+    echo '{"result": "sat", "values": [1], "nodes": {}, "invariant": {"name": 1}}' > "$entry"
+done
+malformed_output=$(model_checker_output)
+diff_values "$uncached_output" "$malformed_output" || fail "Malformed answers in the cache changed the output."
+
+rm -r "$SOLTMPDIR"
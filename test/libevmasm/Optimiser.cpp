@@ -30,10 +30,12 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 
 #include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/count_if.hpp>
 
 #include <string>
 #include <tuple>
@@ -47,6 +49,15 @@ namespace solidity::frontend::test
 
 namespace
 {
+	/// Exposes the parameters of the compute method of the constant optimiser.
+	class TestComputeMethod: public ComputeMethod
+	{
+	public:
+		using ComputeMethod::Params;
+		TestComputeMethod(Params const& _params, u256 const& _value, ConstantRepresentationCache* _cache):
+			ComputeMethod(_params, _value, _cache) {}
+	};
+
 	AssemblyItems addDummyLocations(AssemblyItems const& _input)
 	{
 		// add dummy locations to each item so that we can check that they are not deleted
@@ -131,6 +142,21 @@ namespace
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 
+	AssemblyItems CSEAcrossBlocks(AssemblyItems const& _input)
+	{
+		bool usesMSize = ranges::any_of(_input, [](AssemblyItem const& _i) {
+			return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
+		});
+		return CommonSubexpressionEliminator::optimiseAcrossBlocks(_input, usesMSize, {}).first;
+	}
+
+	size_t countInstructions(AssemblyItems const& _items, Instruction _instruction)
+	{
+		return static_cast<size_t>(ranges::count_if(_items, [&](AssemblyItem const& _item) {
+			return _item == AssemblyItem{_instruction};
+		}));
+	}
+
 	AssemblyItems CFG(AssemblyItems const& _input)
 	{
 		AssemblyItems output = _input;
@@ -1649,6 +1675,91 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(cse_across_blocks_jumpi_fallthrough)
+{
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::DUP1,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP
+	};
+	BOOST_CHECK_EQUAL(countInstructions(fullCSE(input), Instruction::SLOAD), 2);
+	BOOST_CHECK_EQUAL(countInstructions(CSEAcrossBlocks(input), Instruction::SLOAD), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_static_jump)
+{
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	BOOST_CHECK_EQUAL(countInstructions(fullCSE(input), Instruction::SLOAD), 2);
+	BOOST_CHECK_EQUAL(countInstructions(CSEAcrossBlocks(input), Instruction::SLOAD), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_dynamic_jump_target)
+{
+	// Tag 1 is also pushed as a value, so it might be the target of a dynamic jump.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::JUMP
+	};
+	BOOST_CHECK_EQUAL(countInstructions(CSEAcrossBlocks(input), Instruction::SLOAD), 2);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks_unmodelled_side_effect)
+{
+	// The CALL might modify storage and breaks the propagation of knowledge.
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		u256(0),
+		u256(0),
+		u256(0),
+		u256(0),
+		u256(0),
+		u256(0),
+		u256(100000),
+		Instruction::CALL,
+		Instruction::POP,
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	BOOST_CHECK_EQUAL(countInstructions(CSEAcrossBlocks(input), Instruction::SLOAD), 2);
+}
+
 BOOST_AUTO_TEST_CASE(inliner)
 {
 	AssemblyItem jumpInto{Instruction::JUMP};
@@ -1915,6 +2026,74 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 }
 
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache)
+{
+	std::vector<u256> values{
+		u256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0000"),
+		u256("0x00000000ffffffffffffffffffffffffffffffffffffffff0000000000000000"),
+		u256("0xffffffff00000000000000000000000000000000000000000000000000000000"),
+		u256("0x1234567812345678123456781234567812345678123456781234567812345678"),
+		u256("0x8000000000000000000000000000000000000000000000000000000000000007"),
+		u256("0xa9059cbb00000000000000000000000000000000000000000000000000000000"),
+		u256("0x0000000000000000000000000000000000000000000000000000000000ffffff"),
+		u256("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff9")
+	};
+	for (EVMVersion evmVersion: {EVMVersion::byzantium(), EVMVersion::constantinople(), EVMVersion{}})
+		for (bool isCreation: {false, true})
+		{
+			TestComputeMethod::Params params;
+			params.isCreation = isCreation;
+			params.runs = 200;
+			params.multiplicity = 2;
+			params.evmVersion = evmVersion;
+			Assembly assembly{evmVersion, isCreation, {}};
+			ConstantRepresentationCache cache;
+			// The second round is served from the cache filled by the first one.
+			for (size_t round = 0; round < 2; ++round)
+				for (u256 const& value: values)
+				{
+					AssemblyItems uncached = TestComputeMethod{params, value, nullptr}.execute(assembly);
+					AssemblyItems cached = TestComputeMethod{params, value, &cache}.execute(assembly);
+					BOOST_CHECK_EQUAL_COLLECTIONS(
+						uncached.begin(), uncached.end(),
+						cached.begin(), cached.end()
+					);
+				}
+			BOOST_CHECK(!cache.entries.empty());
+			BOOST_CHECK(cache.hits > 0);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache_shared_by_subassemblies)
+{
+	Assembly::OptimiserSettings settings;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.constantRepresentationCache = std::make_shared<ConstantRepresentationCache>();
+
+	// Neither the constant nor its parts are searched for twice within one assembly.
+	u256 const constant("0x8000000000000000000000000000000000000000000000000000000000000007");
+	auto subWithConstant = [&]() {
+		AssemblyPointer sub = std::make_shared<Assembly>(settings.evmVersion, false, std::string{});
+		sub->append(constant);
+		sub->append(Instruction::ADD);
+		return sub;
+	};
+
+	subWithConstant()->optimise(settings);
+	BOOST_CHECK(!settings.constantRepresentationCache->entries.empty());
+	BOOST_CHECK_EQUAL(settings.constantRepresentationCache->hits, 0);
+
+	// The second sub-assembly uses the representation found for the first one.
+	settings.constantRepresentationCache = std::make_shared<ConstantRepresentationCache>();
+	Assembly main{settings.evmVersion, true, {}};
+	main.appendSubroutine(subWithConstant());
+	main.appendSubroutine(subWithConstant());
+	main.optimise(settings);
+	BOOST_CHECK_EQUAL(settings.constantRepresentationCache->hits, 1);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
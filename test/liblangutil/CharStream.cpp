@@ -130,6 +130,33 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
 }
 
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	auto const toLineColumn = [](int _position, std::string const& _text) {
+		LineColumn lineColumn = CharStream{_text, "source"}.translatePositionToLineColumn(_position);
+		return std::make_pair(lineColumn.line, lineColumn.column);
+	};
+
+	BOOST_CHECK(toLineColumn(0, "") == std::make_pair(0, 0));
+	BOOST_CHECK(toLineColumn(5, "") == std::make_pair(0, 0));
+	BOOST_CHECK(toLineColumn(2, "ABC") == std::make_pair(0, 2));
+	BOOST_CHECK(toLineColumn(3, "ABC\nDEF") == std::make_pair(0, 3));
+	BOOST_CHECK(toLineColumn(4, "ABC\nDEF") == std::make_pair(1, 0));
+	BOOST_CHECK(toLineColumn(7, "ABC\nDEF") == std::make_pair(1, 3));
+	BOOST_CHECK(toLineColumn(100, "ABC\nDEF") == std::make_pair(1, 3));
+	BOOST_CHECK(toLineColumn(8, "ABC\nDEF\n") == std::make_pair(2, 0));
+	BOOST_CHECK(toLineColumn(5, "\n\n\n\nAB") == std::make_pair(4, 1));
+
+	std::string const text = "contract C {\n\tfunction f() public {}\n\n}\n";
+	CharStream stream{text, "source"};
+	for (int position = 0; position <= static_cast<int>(text.size()); ++position)
+	{
+		LineColumn lineColumn = stream.translatePositionToLineColumn(position);
+		BOOST_CHECK_EQUAL(stream.translateLineColumnToPosition(lineColumn), position);
+		BOOST_CHECK_EQUAL(CharStream::translateLineColumnToPosition(text, lineColumn), position);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
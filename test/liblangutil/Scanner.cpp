@@ -58,6 +58,27 @@ BOOST_AUTO_TEST_CASE(smoke_test)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(long_runs)
+{
+	// Whitespace, comments, identifiers and strings longer than the blocks scanned at once.
+	std::string const identifier = "abcdefghijklmnopqrstuvwxyz_$0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	std::string const text = "a little longer string literal, with 'quotes' inside";
+	CharStream stream(
+		"  \t\n\r                                    " + identifier + "/* a multi-line comment that is ** long */ " +
+		"// a single-line comment that is long as well \n\"" + text + "\" unicode'\xc3\xa9 \xe2\x80\xa8 " + text + "'",
+		""
+	);
+	Scanner scanner(stream);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 41);
+	BOOST_CHECK_EQUAL(scanner.currentLocation().end, 41 + static_cast<int>(identifier.size()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalStringEndQuote);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_assign)
 {
 	CharStream stream("let a := 1", "");
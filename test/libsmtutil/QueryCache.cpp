@@ -0,0 +1,168 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+Json::Value parse(std::string const& _json)
+{
+	Json::Value json;
+	BOOST_REQUIRE(jsonParseStrict(_json, json));
+	return json;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(QueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(store_and_lookup)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	QueryCache cache(tempDir.path() / "cache");
+
+	BOOST_CHECK(!cache.lookup("z3", "(check-sat)"));
+	cache.store("z3", "(check-sat)", std::string("sat\n"));
+	BOOST_CHECK(cache.lookup("z3", "(check-sat)") == "sat\n");
+	// The answer depends on both the solver and the query.
+	BOOST_CHECK(!cache.lookup("cvc4", "(check-sat)"));
+	BOOST_CHECK(!cache.lookup("z3", "(check-sat)\n"));
+
+	cache.store("z3", "(check-sat)", std::string("unsat\n"));
+	BOOST_CHECK(cache.lookup("z3", "(check-sat)") == "unsat\n");
+	// Answers that are not valid JSON are not returned as JSON.
+	BOOST_CHECK(!cache.lookupJson("z3", "(check-sat)"));
+
+	Json::Value answer{Json::objectValue};
+	answer["result"] = QueryCache::toJson(CheckResult::UNSATISFIABLE);
+	cache.store("z3", "(check-sat)", answer);
+	auto cachedAnswer = cache.lookupJson("z3", "(check-sat)");
+	BOOST_REQUIRE(cachedAnswer);
+	BOOST_CHECK(*cachedAnswer == answer);
+
+	// Answers are shared between instances using the same directory.
+	BOOST_CHECK(QueryCache(tempDir.path() / "cache").lookupJson("z3", "(check-sat)") == cachedAnswer);
+}
+
+BOOST_AUTO_TEST_CASE(check_result_round_trip)
+{
+	for (CheckResult result: {
+		CheckResult::SATISFIABLE,
+		CheckResult::UNSATISFIABLE,
+		CheckResult::UNKNOWN,
+		CheckResult::CONFLICTING,
+		CheckResult::ERROR
+	})
+		BOOST_CHECK(QueryCache::checkResultFromJson(QueryCache::toJson(result)) == result);
+}
+
+BOOST_AUTO_TEST_CASE(expression_round_trip)
+{
+	auto tupleSort = std::make_shared<TupleSort>(
+		"tuple",
+		std::vector<std::string>{"first", "second"},
+		std::vector<SortPointer>{SortProvider::uintSort, std::make_shared<BitVectorSort>(8)}
+	);
+	auto arraySort = std::make_shared<ArraySort>(SortProvider::sintSort, tupleSort);
+	auto functionSort = std::make_shared<FunctionSort>(
+		std::vector<SortPointer>{arraySort, SortProvider::boolSort},
+		SortProvider::boolSort
+	);
+
+	Expression a("a", {}, arraySort);
+	Expression b("b", {}, SortProvider::boolSort);
+	Expression x("x", {}, SortProvider::sintSort);
+	Expression const expressions[] = {
+		Expression(true),
+		x + 1 <= 2,
+		Expression("f", {Expression::store(a, x, Expression::select(a, 0)), b}, SortProvider::boolSort),
+		Expression("f", {}, functionSort),
+		Expression::const_array(Expression(std::make_shared<SortSort>(arraySort)), Expression::select(a, x))
+	};
+	for (Expression const& expression: expressions)
+	{
+		Json::Value json = QueryCache::toJson(expression);
+		auto parsed = QueryCache::expressionFromJson(json);
+		BOOST_REQUIRE(parsed);
+		BOOST_CHECK_EQUAL(parsed->name, expression.name);
+		BOOST_CHECK(*parsed->sort == *expression.sort);
+		BOOST_CHECK(QueryCache::toJson(*parsed) == json);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(malformed_check_result)
+{
+	for (Json::Value const& json: {Json::Value{}, Json::Value{1}, Json::Value{"Sat"}, parse("[\"sat\"]"), parse("{\"result\": \"sat\"}")})
+		BOOST_CHECK(!QueryCache::checkResultFromJson(json));
+}
+
+BOOST_AUTO_TEST_CASE(malformed_expression)
+{
+	BOOST_CHECK(!QueryCache::expressionFromJson(Json::Value{}));
+	BOOST_CHECK(!QueryCache::expressionFromJson(Json::Value{"x"}));
+	for (std::string const& json: {
+		"{\"sort\": {\"kind\": \"bool\"}}",
+		"{\"name\": 1, \"sort\": {\"kind\": \"bool\"}}",
+		"{\"name\": \"x\"}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"real\"}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"int\"}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"bitvector\", \"size\": -8}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"array\", \"domain\": {\"kind\": \"bool\"}}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"function\", \"domain\": {}, \"codomain\": {\"kind\": \"bool\"}}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"sort\", \"inner\": 1}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"tuple\", \"name\": \"t\", \"members\": [\"a\"], \"components\": []}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"tuple\", \"name\": \"t\", \"members\": [1], \"components\": [{\"kind\": \"bool\"}]}}",
+		"{\"name\": \"x\", \"sort\": {\"kind\": \"bool\"}, \"arguments\": {}}",
+		"{\"name\": \"not\", \"sort\": {\"kind\": \"bool\"}, \"arguments\": [{\"name\": \"x\"}]}"
+	})
+		BOOST_CHECK_MESSAGE(!QueryCache::expressionFromJson(parse(json)), json);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_entry)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	QueryCache cache(tempDir.path());
+	cache.store("z3", "(check-sat)", parse("{\"result\": \"sat\"}"));
+
+	// Another process may have left an unfinished or corrupted entry.
+	for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path()))
+		std::ofstream(entry.path().string(), std::ios::trunc) << "{\"result\": ";
+	BOOST_CHECK(cache.lookup("z3", "(check-sat)") == "{\"result\": ");
+	BOOST_CHECK(!cache.lookupJson("z3", "(check-sat)"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
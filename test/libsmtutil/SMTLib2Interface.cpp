@@ -0,0 +1,189 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace solidity::frontend;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// Callback that records what it is sent and answers with the given responses per kind.
+class RecordingCallback
+{
+public:
+	RecordingCallback(std::string _sessionResponse, std::string _queryResponse):
+		m_sessionResponse(std::move(_sessionResponse)),
+		m_queryResponse(std::move(_queryResponse))
+	{}
+
+	ReadCallback::Callback callback()
+	{
+		return [this](std::string const& _kind, std::string const& _data) {
+			m_requests.emplace_back(_kind, _data);
+			if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTSession))
+				return ReadCallback::Result{true, m_sessionResponse};
+			return ReadCallback::Result{true, m_queryResponse};
+		};
+	}
+
+	/// @returns the requests since the last call.
+	std::vector<std::pair<std::string, std::string>> requests() { return std::exchange(m_requests, {}); }
+
+private:
+	std::string m_sessionResponse;
+	std::string m_queryResponse;
+	std::vector<std::pair<std::string, std::string>> m_requests;
+};
+
+std::string const session = ReadCallback::kindString(ReadCallback::Kind::SMTSession);
+std::string const query = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+std::string const header =
+	"(set-option :produce-models true)\n"
+	"(set-logic ALL)\n";
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTLib2InterfaceTest)
+
+BOOST_AUTO_TEST_CASE(session_sends_only_new_commands)
+{
+	RecordingCallback recorder("unsat\n", "unsat\n");
+	SMTLib2Interface solver({}, recorder.callback(), std::nullopt, true);
+	Expression x("x", {}, SortProvider::sintSort);
+	solver.declareVariable("x", SortProvider::sintSort);
+	solver.addAssertion(x > 0);
+
+	solver.push();
+	solver.addAssertion(x > 1);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(recorder.requests() == (std::vector<std::pair<std::string, std::string>>{{
+		session,
+		"(reset)\n" +
+		header +
+		"(declare-fun |x| () Int)\n"
+		"(assert (> x 0))\n"
+		"(push 1)\n"
+		"(assert (> x 1))\n"
+		"(push 1)\n"
+		"(check-sat)\n"
+		"(pop 1)\n"
+	}}));
+
+	// The popped scope is removed from the solver, the new one is sent.
+	solver.pop();
+	solver.push();
+	solver.addAssertion(x < 0);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(recorder.requests() == (std::vector<std::pair<std::string, std::string>>{{
+		session,
+		"(pop 1)\n"
+		"(push 1)\n"
+		"(assert (< x 0))\n"
+		"(push 1)\n"
+		"(check-sat)\n"
+		"(pop 1)\n"
+	}}));
+
+	// Commands added to a scope the solver already has are sent on their own.
+	solver.addAssertion(x < 2);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(recorder.requests() == (std::vector<std::pair<std::string, std::string>>{{
+		session,
+		"(assert (< x 2))\n"
+		"(push 1)\n"
+		"(check-sat)\n"
+		"(pop 1)\n"
+	}}));
+
+	solver.reset();
+	solver.declareVariable("y", SortProvider::boolSort);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(recorder.requests() == (std::vector<std::pair<std::string, std::string>>{{
+		session,
+		"(reset)\n" +
+		header +
+		"(declare-fun |y| () Bool)\n"
+		"(push 1)\n"
+		"(check-sat)\n"
+		"(pop 1)\n"
+	}}));
+}
+
+BOOST_AUTO_TEST_CASE(session_error_falls_back_to_full_query)
+{
+	// The solver rejected one of the commands before the check.
+	RecordingCallback recorder("(error \"line 2 column 10: unsupported\")\nsat\n", "unsat\n");
+	SMTLib2Interface solver({}, recorder.callback(), std::nullopt, true);
+	solver.declareVariable("x", SortProvider::sintSort);
+	solver.addAssertion(Expression("x", {}, SortProvider::sintSort) > 0);
+
+	std::string const fullQuery =
+		header + "(declare-fun |x| () Int)\n"
+		"(assert (> x 0))\n"
+		"(check-sat)\n";
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	auto requests = recorder.requests();
+	BOOST_REQUIRE_EQUAL(requests.size(), 2);
+	BOOST_CHECK_EQUAL(requests[0].first, session);
+	BOOST_CHECK(requests[1] == std::make_pair(query, fullQuery));
+
+	// The session is not used anymore.
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(recorder.requests() == (std::vector<std::pair<std::string, std::string>>{{query, fullQuery}}));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_subterms)
+{
+	SMTLib2Interface solver;
+	Expression x("x", {}, SortProvider::sintSort);
+	solver.declareVariable("x", SortProvider::sintSort);
+
+	Expression product = (x + 100) * (x + 200);
+	Expression square = product * product;
+	solver.addAssertion(square + product > square);
+	// Bound terms may refer to the ones bound before them.
+	Expression cube = square * product;
+	solver.addAssertion(cube + cube + cube > square);
+	// Binding a short term would make the assertion longer.
+	Expression sum = x + 1;
+	solver.addAssertion(sum * sum > 0);
+
+	BOOST_CHECK_EQUAL(
+		solver.dumpQuery({}),
+		header +
+		"(declare-fun |x| () Int)\n"
+		"(assert (let ((_s!0 (* (+ x 100) (+ x 200)))) (> (+ (* _s!0 _s!0) _s!0) (* _s!0 _s!0))))\n"
+		"(assert (let ((_s!0 (* (+ x 100) (+ x 200)))) (let ((_s!1 (* (* _s!0 _s!0) _s!0))) (> (+ (+ _s!1 _s!1) _s!1) (* _s!0 _s!0)))))\n"
+		"(assert (> (* (+ x 1) (+ x 1)) 0))\n"
+		"(check-sat)\n"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+namespace
+{
+
+using Result = std::tuple<CheckResult, std::vector<std::string>, std::vector<std::string>>;
+
+/// Checks `0 < x < 2` with all available solvers.
+Result checkX(frontend::ReadCallback::Callback const& _smtCallback, bool _crossCheckSolvers)
+{
+	SMTPortfolio portfolio({}, _smtCallback, SMTSolverChoice::All(), std::nullopt, false, _crossCheckSolvers);
+	Expression x = portfolio.newVariable("x", SortProvider::sintSort);
+	portfolio.addAssertion(x > 0);
+	portfolio.addAssertion(x < 2);
+	auto [result, values] = portfolio.check({x});
+	return {result, values, portfolio.unhandledQueries()};
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(racing_does_not_change_unhandled_queries)
+{
+	Result const crossChecked = checkX({}, true);
+	// Without a callback the SMT-LIB2 solver cannot answer, but it always reports its query.
+	BOOST_CHECK_EQUAL(std::get<2>(crossChecked).size(), 1);
+	// The race is repeated, because its outcome used to depend on timing.
+	for (size_t i = 0; i < 20; ++i)
+		BOOST_CHECK(checkX({}, false) == crossChecked);
+}
+
+BOOST_AUTO_TEST_CASE(racing_takes_answers_in_solver_order)
+{
+	// The SMT-LIB2 solver comes first in the portfolio, but answers later than the other solvers
+	// and with a different model.
+	frontend::ReadCallback::Callback const slowSolver = [](std::string const&, std::string const&) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return frontend::ReadCallback::Result{true, "sat\n((x 5))\n"};
+	};
+	Result const crossChecked = checkX(slowSolver, true);
+	BOOST_CHECK(std::get<0>(crossChecked) == CheckResult::SATISFIABLE);
+	BOOST_CHECK(std::get<1>(crossChecked) == std::vector<std::string>{"5"});
+	BOOST_CHECK(checkX(slowSolver, false) == crossChecked);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#ifdef HAVE_Z3
+
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/Z3CHCInterface.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(Z3CHCInterfaceTest)
+
+BOOST_AUTO_TEST_CASE(copy_replays_in_original_order)
+{
+	if (!Z3Interface::available())
+		return;
+
+	auto intToBool = std::make_shared<FunctionSort>(std::vector<SortPointer>{SortProvider::sintSort}, SortProvider::boolSort);
+	auto toBool = std::make_shared<FunctionSort>(std::vector<SortPointer>{}, SortProvider::boolSort);
+
+	Z3CHCInterface solver;
+	solver.declareVariable("P", intToBool);
+	solver.declareVariable("error", toBool);
+	Expression p("P", {}, intToBool);
+	Expression error("error", {}, toBool);
+	solver.registerRelation(p);
+	solver.registerRelation(error);
+
+	Expression x("x", {}, SortProvider::sintSort);
+	solver.declareVariable("x", SortProvider::sintSort);
+	solver.addRule(Expression::implies(x == 1, Expression("P", {x}, SortProvider::boolSort)), "base");
+
+	// Redeclaring `x` with a different sort only affects the rules added afterwards.
+	Expression y("y", {}, SortProvider::sintSort);
+	solver.declareVariable("x", SortProvider::boolSort);
+	solver.declareVariable("y", SortProvider::sintSort);
+	solver.addRule(
+		Expression::implies(Expression("P", {y}, SortProvider::boolSort) && y > 0, Expression("error", {}, SortProvider::boolSort)),
+		"error_rule"
+	);
+
+	Expression query("error", {}, SortProvider::boolSort);
+	BOOST_CHECK(std::get<0>(solver.query(query)) == CheckResult::SATISFIABLE);
+	std::unique_ptr<Z3CHCInterface> copy = solver.copy();
+	BOOST_CHECK(std::get<0>(copy->query(query)) == CheckResult::SATISFIABLE);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_cache_entries_are_misses)
+{
+	if (!Z3Interface::available())
+		return;
+
+	util::TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = std::make_shared<QueryCache>(tempDir.path());
+	auto const query = [&]() {
+		auto toBool = std::make_shared<FunctionSort>(std::vector<SortPointer>{}, SortProvider::boolSort);
+		Z3CHCInterface solver;
+		solver.setQueryCache(cache);
+		solver.declareVariable("error", toBool);
+		solver.registerRelation(Expression("error", {}, toBool));
+		Expression error("error", {}, SortProvider::boolSort);
+		solver.addRule(Expression::implies(Expression(true), error), "error_rule");
+		return std::get<0>(solver.query(error));
+	};
+
+	BOOST_CHECK(query() == CheckResult::SATISFIABLE);
+	for (std::string const& answer: {
+		"{\"result\": \"unsat\"}",
+		"{\"result\": \"unsat\", \"invariant\": {\"name\": \"true\"}, \"nodes\": [[-1, {}]], \"edges\": []}",
+		"{\"result\": \"unsat\", \"invariant\": {\"name\": \"true\", \"sort\": {\"kind\": \"bool\"}}, \"nodes\": [], \"edges\": [[0, [\"1\"]]]}",
+		"[\"unsat\"]"
+	})
+	{
+		for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path()))
+			std::ofstream(entry.path().string(), std::ios::trunc) << answer;
+		BOOST_CHECK_MESSAGE(query() == CheckResult::SATISFIABLE, answer);
+	}
+	// A valid entry is used even if it is wrong.
+	for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path()))
+		std::ofstream(entry.path().string(), std::ios::trunc) <<
+			"{\"result\": \"unsat\", \"invariant\": {\"name\": \"true\", \"sort\": {\"kind\": \"bool\"}}, \"nodes\": [], \"edges\": []}";
+	BOOST_CHECK(query() == CheckResult::UNSATISFIABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the inline assembly cache of the compiler context.
+ */
+
+#include <libsolidity/codegen/CompilerContext.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace solidity::evmasm;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const code = "{ mstore(calldataload(0), add(calldataload(32), calldataload(64))) }";
+
+/// Appends @a code at @a _location and @returns the items that were appended.
+AssemblyItems appendCode(CompilerContext& _context, SourceLocation const& _location, OptimiserSettings const& _settings)
+{
+	size_t start = _context.assembly().items().size();
+	_context.assemblyPtr()->setSourceLocation(_location);
+	_context.appendInlineAssembly(code, {}, {}, false, _settings);
+	AssemblyItems const& items = _context.assembly().items();
+	return AssemblyItems(items.begin() + static_cast<ptrdiff_t>(start), items.end());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilerContextTest)
+
+BOOST_AUTO_TEST_CASE(optimized_inline_assembly_cache)
+{
+	auto sourceName = std::make_shared<std::string>("A.sol");
+	SourceLocation const first{0, 10, sourceName};
+	SourceLocation const second{20, 30, sourceName};
+	OptimiserSettings const settings = OptimiserSettings::standard();
+
+	CompilerContext context(solidity::test::CommonOptions::get().evmVersion(), RevertStrings::Default);
+	AssemblyItems const firstItems = appendCode(context, first, settings);
+	BOOST_CHECK_EQUAL(context.inlineAssemblyCacheHits(), 0);
+	BOOST_REQUIRE(!firstItems.empty());
+	for (AssemblyItem const& item: firstItems)
+		BOOST_CHECK(item.location() == first);
+
+	// The optimized snippet is reused and its debug data is moved to the current location.
+	AssemblyItems const secondItems = appendCode(context, second, settings);
+	BOOST_CHECK_EQUAL(context.inlineAssemblyCacheHits(), 1);
+	BOOST_CHECK(secondItems == firstItems);
+	for (AssemblyItem const& item: secondItems)
+		BOOST_CHECK(item.location() == second);
+
+	BOOST_CHECK(appendCode(context, first, settings) == firstItems);
+	BOOST_CHECK_EQUAL(context.inlineAssemblyCacheHits(), 2);
+
+	// The same code compiled with other settings is not taken from the cache.
+	OptimiserSettings otherSettings = settings;
+	otherSettings.expectedExecutionsPerDeployment = 1000;
+	appendCode(context, first, otherSettings);
+	appendCode(context, first, OptimiserSettings::none());
+	BOOST_CHECK_EQUAL(context.inlineAssemblyCacheHits(), 2);
+
+	// Reusing the snippet gives the same code as optimizing it again.
+	CompilerContext freshContext(solidity::test::CommonOptions::get().evmVersion(), RevertStrings::Default);
+	BOOST_CHECK(appendCode(freshContext, second, settings) == secondItems);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
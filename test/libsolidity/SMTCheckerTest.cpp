@@ -124,6 +124,18 @@ SMTCheckerTest::SMTCheckerTest(std::string const& _filename): SyntaxTest(_filena
 
 	auto const& bmcLoopIterations = m_reader.sizetSetting("BMCLoopIterations", 1);
 	m_modelCheckerSettings.bmcLoopIterations = std::optional<unsigned>{bmcLoopIterations};
+
+	m_modelCheckerSettings.threads = static_cast<unsigned>(m_reader.sizetSetting("SMTThreads", 1));
+	if (m_modelCheckerSettings.threads == 0)
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid number of SMT threads."));
+
+	auto const& batchTargets = m_reader.stringSetting("SMTBatchTargets", "no");
+	if (batchTargets == "no")
+		m_modelCheckerSettings.batchTargets = false;
+	else if (batchTargets == "yes")
+		m_modelCheckerSettings.batchTargets = true;
+	else
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid SMT batch targets choice."));
 }
 
 void SMTCheckerTest::setupCompiler(CompilerStack& _compiler)
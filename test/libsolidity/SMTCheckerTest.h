@@ -58,6 +58,10 @@ protected:
 		Set in m_modelCheckerSettings.
 	BMCLoopIterations: number of loop iterations for BMC engine, the default is 1.
 		Set in m_modelCheckerSettings.
+	SMTThreads: number of threads CHC uses to solve the queries, the default is 1.
+		Set in m_modelCheckerSettings.
+	SMTBatchTargets: `yes`, `no`, where the default is `no`.
+		Set in m_modelCheckerSettings.
 	*/
 
 	ModelCheckerSettings m_modelCheckerSettings;
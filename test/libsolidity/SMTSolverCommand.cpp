@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTSolverCommandTest)
+
+BOOST_AUTO_TEST_CASE(session_without_solver)
+{
+	SMTSolverCommand command;
+	auto result = command.continueSession(ReadCallback::kindString(ReadCallback::Kind::SMTSession), "(check-sat)\n");
+	BOOST_CHECK(!result.success);
+}
+
+#if !defined(_WIN32)
+BOOST_AUTO_TEST_CASE(session_solver_stops)
+{
+	SMTSolverCommand command;
+	// The "solver" exits without reading its input, so the request cannot be written completely
+	// and the write fails with SIGPIPE.
+	command.setSessionSolver("sleep 0.1");
+	std::string const commands(1 << 20, ' ');
+	for (size_t i = 0; i < 2; ++i)
+	{
+		auto result = command.continueSession(ReadCallback::kindString(ReadCallback::Kind::SMTSession), commands);
+		BOOST_CHECK(!result.success);
+		BOOST_CHECK_EQUAL(result.responseOrErrorMessage, "sleep stopped unexpectedly.");
+	}
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
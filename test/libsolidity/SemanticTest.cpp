@@ -107,6 +107,7 @@ SemanticTest::SemanticTest(
 	m_revertStrings = revertStrings.value();
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
+	m_splitLargeSwitches = m_reader.boolSetting("splitLargeSwitches", false);
 
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
@@ -352,6 +353,7 @@ TestCase::TestResult SemanticTest::runTest(
 	reset();
 
 	m_compileViaYul = _isYulRun;
+	ScopedSaveAndRestore splitLargeSwitches(m_optimiserSettings.splitLargeSwitches, bool(m_splitLargeSwitches));
 
 	if (_isYulRun)
 		AnsiColorized(_stream, _formatted, {BOLD, CYAN}) << _linePrefix << "Running via Yul: " << std::endl;
@@ -121,6 +121,7 @@ private:
 	bool m_testCaseWantsLegacyRun = true;
 	bool m_runWithABIEncoderV1Only = false;
 	bool m_allowNonExistingFunctions = false;
+	bool m_splitLargeSwitches = false;
 	bool m_gasCostFailure = false;
 	bool m_enforceGasCost = false;
 	RequiresYulOptimizer m_requiresYulOptimizer{};
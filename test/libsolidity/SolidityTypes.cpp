@@ -24,9 +24,12 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace solidity::langutil;
 
 namespace solidity::frontend::test
@@ -245,6 +248,106 @@ BOOST_AUTO_TEST_CASE(encoded_sizes)
 	BOOST_CHECK_EQUAL(twoDimArray.calldataEncodedSize(false), 9 * 3 * 32);
 }
 
+BOOST_AUTO_TEST_CASE(implicit_conversion_cache)
+{
+	TypeProvider::reset();
+	ArrayType const* storageArray = TypeProvider::array(DataLocation::Storage, TypeProvider::uint(24), 9);
+	ArrayType const* memoryArray = TypeProvider::array(DataLocation::Memory, TypeProvider::uint(24), 9);
+	ArrayType const* dynamicMemoryArray = TypeProvider::array(DataLocation::Memory, TypeProvider::uint(24));
+
+	BOOST_CHECK(storageArray->isImplicitlyConvertibleTo(*memoryArray));
+	BOOST_CHECK(!storageArray->isImplicitlyConvertibleTo(*dynamicMemoryArray));
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().hits, 0);
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().misses, 2);
+
+	BOOST_CHECK(storageArray->isImplicitlyConvertibleTo(*memoryArray));
+	BOOST_CHECK(!storageArray->isImplicitlyConvertibleTo(*dynamicMemoryArray));
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().hits, 2);
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().misses, 2);
+
+	TypeProvider::reset();
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().hits, 0);
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().misses, 0);
+}
+
+BOOST_AUTO_TEST_CASE(implicit_conversion_cache_skips_contract_types)
+{
+	TypeProvider::reset();
+	int64_t id = 0;
+	ContractDefinition base(++id, SourceLocation{}, std::make_shared<std::string>("Base"), SourceLocation{}, {}, {}, {}, ContractKind::Contract);
+	ContractDefinition derived(++id, SourceLocation{}, std::make_shared<std::string>("Derived"), SourceLocation{}, {}, {}, {}, ContractKind::Contract);
+	ArrayType const* derivedArray = TypeProvider::array(DataLocation::Storage, TypeProvider::contract(derived));
+	auto const* baseArray = TypeProvider::withLocation(
+		TypeProvider::array(DataLocation::Storage, TypeProvider::contract(base)),
+		DataLocation::Storage,
+		false
+	);
+	TupleType const* derivedTuple = TypeProvider::tuple({derivedArray});
+	TupleType const* baseTuple = TypeProvider::tuple({baseArray});
+
+	// The inheritance hierarchy is not known yet.
+	BOOST_CHECK(!derivedArray->isImplicitlyConvertibleTo(*baseArray));
+	BOOST_CHECK(!derivedTuple->isImplicitlyConvertibleTo(*baseTuple));
+
+	derived.annotation().linearizedBaseContracts = {&derived, &base};
+	BOOST_CHECK(derivedArray->isImplicitlyConvertibleTo(*baseArray));
+	BOOST_CHECK(derivedTuple->isImplicitlyConvertibleTo(*baseTuple));
+
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().hits, 0);
+	BOOST_CHECK_EQUAL(TypeProvider::relationCacheStatistics().misses, 0);
+	TypeProvider::reset();
+}
+
+BOOST_AUTO_TEST_CASE(type_provider_of_compiler_stack)
+{
+	IntegerType const* defaultUint = TypeProvider::uint256();
+	auto compilerStack = std::make_unique<CompilerStack>();
+	auto otherCompilerStack = std::make_unique<CompilerStack>();
+	IntegerType const* compilationUint = nullptr;
+	{
+		TypeProvider::Activation activation(compilerStack->typeProvider());
+		compilationUint = TypeProvider::uint256();
+		{
+			TypeProvider::Activation otherActivation(otherCompilerStack->typeProvider());
+			BOOST_CHECK(TypeProvider::uint256() != compilationUint);
+		}
+		BOOST_CHECK(TypeProvider::uint256() == compilationUint);
+	}
+	BOOST_CHECK(compilationUint != defaultUint);
+	BOOST_CHECK(TypeProvider::uint256() == defaultUint);
+
+	// Other threads share the types of the compilation after activating its provider.
+	IntegerType const* otherThreadUint = nullptr;
+	std::thread([&]() {
+		TypeProvider::Activation activation(compilerStack->typeProvider());
+		otherThreadUint = TypeProvider::uint256();
+	}).join();
+	BOOST_CHECK(otherThreadUint == compilationUint);
+
+	// The provider cannot be active on two threads at the same time.
+	{
+		TypeProvider::Activation activation(compilerStack->typeProvider());
+		bool rejected = false;
+		std::thread([&]() {
+			try
+			{
+				TypeProvider::Activation otherThreadActivation(compilerStack->typeProvider());
+			}
+			catch (langutil::InternalCompilerError const&)
+			{
+				rejected = true;
+			}
+		}).join();
+		BOOST_CHECK(rejected);
+		BOOST_CHECK(TypeProvider::uint256() == compilationUint);
+	}
+
+	// Compiler stacks do not depend on the order in which they are destroyed.
+	compilerStack.reset();
+	otherCompilerStack.reset();
+	BOOST_CHECK(TypeProvider::uint256() == defaultUint);
+}
+
 BOOST_AUTO_TEST_CASE(helper_bool_result)
 {
 	BoolResult r1{true};
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1225,6 +1226,42 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_split_large_switches)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "runs": 100000, "details": {
+				"yul": true,
+				"yulDetails": { "splitLargeSwitches": true }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f0() public {} function f1() public {} function f2() public {} function f3() public {} function f4() public {} function f5() public {} function f6() public {} function f7() public {} function f8() public {} function f9() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails.isObject());
+	BOOST_CHECK(yulDetails["splitLargeSwitches"].asBool() == true);
+	BOOST_CHECK(yulDetails["stackAllocation"].asBool() == true);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1783,6 +1820,115 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	Json::Value errors;
+	errors[0]["message"] = "Warning";
+	Json::Value source;
+	source["id"] = 0;
+	auto writeOutput = [&](solidity::frontend::StandardCompiler::OutputWriter& _writer) {
+		_writer.beginObject("contracts");
+		_writer.beginObject("A.sol");
+		_writer.member("A", Json::objectValue);
+		_writer.endObject();
+		_writer.endObject();
+		_writer.member("errors", errors);
+		_writer.beginObject("sources");
+		_writer.member("A.sol", source);
+		_writer.endObject();
+	};
+
+	Json::Value collected;
+	solidity::frontend::StandardCompiler::OutputWriter collectingWriter(collected);
+	writeOutput(collectingWriter);
+	collectingWriter.finish();
+
+	for (auto format: {util::JsonFormat{}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		std::ostringstream streamed;
+		util::JsonStreamWriter stream(streamed, format);
+		solidity::frontend::StandardCompiler::OutputWriter streamingWriter(stream);
+		writeOutput(streamingWriter);
+		streamingWriter.finish();
+
+		BOOST_CHECK_EQUAL(streamed.str(), util::jsonPrint(collected, format));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_failure)
+{
+	Json::Value fatalError;
+	fatalError["errors"][0]["message"] = "Fatal";
+	fatalError["errors"][0]["type"] = "InternalCompilerError";
+
+	// Failures in the contracts, after the errors and in the sources.
+	for (size_t failAfter: {2, 5, 7})
+	{
+		std::ostringstream output;
+		util::JsonStreamWriter stream(output, util::JsonFormat{});
+		solidity::frontend::StandardCompiler::OutputWriter writer(stream);
+		size_t step = 0;
+		auto proceed = [&]() { return step++ < failAfter; };
+		if (proceed()) writer.beginObject("contracts");
+		if (proceed()) writer.beginObject("A.sol");
+		if (proceed()) writer.member("A", Json::objectValue);
+		if (proceed()) writer.endObject();
+		if (proceed()) writer.endObject();
+		if (proceed()) writer.member("errors", Json::Value(Json::arrayValue));
+		if (proceed()) writer.beginObject("sources");
+		if (proceed()) writer.member("A.sol", Json::objectValue);
+		writer.fail(fatalError);
+		writer.finish();
+
+		Json::Value result;
+		BOOST_REQUIRE_MESSAGE(util::jsonParseStrict(output.str(), result), output.str());
+		BOOST_CHECK(result["errors"] == fatalError["errors"]);
+		BOOST_CHECK(result.isMember("contracts"));
+		BOOST_CHECK(!result.isMember("sources"));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_buffers_printed_sources)
+{
+	Json::Value errors;
+	errors[0]["message"] = "Warning";
+	Json::Value source;
+	source["id"] = 0;
+	for (unsigned i = 0; i < 100; ++i)
+		source["ast"]["nodes"][i]["nodeType"] = "VariableDeclaration";
+
+	util::JsonFormat format{util::JsonFormat::Pretty};
+	std::ostringstream streamed;
+	util::JsonStreamWriter stream(streamed, format);
+	solidity::frontend::StandardCompiler::OutputWriter writer(stream);
+	writer.beginObject("contracts");
+	writer.beginObject("A.sol");
+	writer.member("A", Json::objectValue);
+	writer.endObject();
+	writer.endObject();
+	writer.member("errors", errors);
+	writer.beginObject("sources");
+	writer.member("A.sol", source);
+	writer.member("B.sol", source);
+	writer.endObject();
+
+	// The sources are kept back, but only as the text they are going to be written as.
+	BOOST_CHECK(streamed.str().find("\"ast\"") == std::string::npos);
+	BOOST_CHECK_EQUAL(
+		writer.bufferedBytes(),
+		util::jsonPrint(errors, format).size() + 2 * util::jsonPrint(source, format).size()
+	);
+
+	writer.finish();
+	BOOST_CHECK_EQUAL(writer.bufferedBytes(), 0);
+	Json::Value expectation;
+	expectation["contracts"]["A.sol"]["A"] = Json::objectValue;
+	expectation["errors"] = errors;
+	expectation["sources"]["A.sol"] = source;
+	expectation["sources"]["B.sol"] = source;
+	BOOST_CHECK_EQUAL(streamed.str(), util::jsonPrint(expectation, format));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -21,6 +21,7 @@ function getColorEnum() pure returns (Color result)
 // -> textDocument/semanticTokens/full {
 // }
 // <- {
+//     "resultId": "1",
 //     "data": [
 //         1, 0, 24, 8, 0,
 //         2, 5, 7, 2, 0,
@@ -34,6 +34,7 @@ contract C
 // -> textDocument/semanticTokens/full {
 // }
 // <- {
+//     "resultId": "1",
 //     "data": [
 //         1, 0, 24, 8, 0,
 //         2, 9, 1, 0, 0,
@@ -0,0 +1,42 @@
+contract C {
+    function f0() public pure returns (uint) { return 100; }
+    function f1() public pure returns (uint) { return 101; }
+    function f2() public pure returns (uint) { return 102; }
+    function f3() public pure returns (uint) { return 103; }
+    function f4() public pure returns (uint) { return 104; }
+    function f5() public pure returns (uint) { return 105; }
+    function f6() public pure returns (uint) { return 106; }
+    function f7() public pure returns (uint) { return 107; }
+    function f8() public pure returns (uint) { return 108; }
+    function f9() public pure returns (uint) { return 109; }
+    function f10() public pure returns (uint) { return 110; }
+    function f11() public pure returns (uint) { return 111; }
+    function f12() public pure returns (uint) { return 112; }
+    function f13() public pure returns (uint) { return 113; }
+    function f14() public pure returns (uint) { return 114; }
+    function f15() public pure returns (uint) { return 115; }
+    function g(uint x) public pure returns (uint) { return x + 1; }
+}
+// ====
+// allowNonExistingFunctions: true
+// compileViaYul: true
+// splitLargeSwitches: true
+// ----
+// f0() -> 100
+// f1() -> 101
+// f2() -> 102
+// f3() -> 103
+// f4() -> 104
+// f5() -> 105
+// f6() -> 106
+// f7() -> 107
+// f8() -> 108
+// f9() -> 109
+// f10() -> 110
+// f11() -> 111
+// f12() -> 112
+// f13() -> 113
+// f14() -> 114
+// f15() -> 115
+// g(uint256): 7 -> 8
+// h() -> FAILURE
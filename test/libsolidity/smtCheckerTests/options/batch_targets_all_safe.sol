@@ -0,0 +1,13 @@
+contract C {
+	uint[][] a;
+	function f(uint[] memory x, uint y) public {
+		a.push(x);
+		a[0].push(y);
+		assert(a[0][a[0].length - 1] == y);
+	}
+}
+// ====
+// SMTEngine: all
+// SMTBatchTargets: yes
+// ----
+// Info 1391: CHC: 6 verification condition(s) proved safe! Enable the model checker option "show proved safe" to see all of them.
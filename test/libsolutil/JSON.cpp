@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -117,6 +119,40 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value jsonChild;
+	jsonChild["3.1"] = "3.1";
+	jsonChild["3.2"] = Json::arrayValue;
+	jsonChild["3.2"].append(Json::objectValue);
+	jsonChild["3.2"][0]["a"] = "b";
+
+	Json::Value json;
+	json["1"] = 1;
+	json["2"] = Json::objectValue;
+	json["3"] = jsonChild;
+	json["4"]["4.1"] = "ऑ ऒ ओ औ क ख";
+
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::ostringstream output;
+		JsonStreamWriter writer(output, format);
+		writer.beginObject();
+		writer.member("1", 1);
+		writer.beginObject("2");
+		writer.endObject();
+		writer.beginObject("3");
+		writer.member("3.1", jsonChild["3.1"]);
+		writer.member("3.2", jsonChild["3.2"]);
+		writer.endObject();
+		writer.beginObject("4");
+		writer.member("4.1", json["4"]["4.1"]);
+		writer.endObject();
+		writer.endObject();
+		BOOST_CHECK_EQUAL(output.str(), jsonPrint(json, format));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
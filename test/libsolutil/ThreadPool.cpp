@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(each_index_once)
+{
+	ThreadPool threadPool(3);
+	BOOST_CHECK_EQUAL(threadPool.workerCount(), 3);
+	// The same workers process the tasks of every call.
+	for (size_t count: {0, 1, 2, 100, 1000})
+	{
+		std::vector<std::atomic<size_t>> calls(count);
+		threadPool.forEach(count, [&](size_t _index) { ++calls[_index]; });
+		for (size_t index = 0; index < count; ++index)
+			BOOST_CHECK_EQUAL(calls[index], 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(without_workers)
+{
+	ThreadPool threadPool(0);
+	std::set<std::thread::id> threads;
+	threadPool.forEach(10, [&](size_t) { threads.insert(std::this_thread::get_id()); });
+	BOOST_CHECK(threads == std::set<std::thread::id>{std::this_thread::get_id()});
+}
+
+BOOST_AUTO_TEST_CASE(exception)
+{
+	ThreadPool threadPool(2);
+	BOOST_CHECK_THROW(
+		threadPool.forEach(100, [](size_t _index) {
+			if (_index == 42)
+				throw std::runtime_error("Task failed.");
+		}),
+		std::runtime_error
+	);
+
+	// The pool can still be used afterwards.
+	std::atomic<size_t> calls = 0;
+	threadPool.forEach(100, [&](size_t) { ++calls; });
+	BOOST_CHECK_EQUAL(calls, 100);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_calls)
+{
+	ThreadPool threadPool(2);
+	std::atomic<size_t> calls = 0;
+	std::vector<std::thread> callers;
+	for (size_t i = 0; i < 4; ++i)
+		callers.emplace_back([&]() { threadPool.forEach(50, [&](size_t) { ++calls; }); });
+	for (std::thread& caller: callers)
+		caller.join();
+	BOOST_CHECK_EQUAL(calls, 200);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -22,6 +22,8 @@
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/backends/evm/StackHelpers.h>
 #include <libyul/Object.h>
 
@@ -46,6 +48,7 @@ ControlFlowGraphTest::ControlFlowGraphTest(std::string const& _filename):
 	m_source = m_reader.source();
 	auto dialectName = m_reader.stringSetting("dialect", "evm");
 	m_dialect = &dialect(dialectName, solidity::test::CommonOptions::get().evmVersion());
+	m_splitLargeSwitches = m_reader.boolSetting("splitLargeSwitches", false);
 	m_expectation = m_reader.simpleExpectations();
 }
 
@@ -206,7 +209,15 @@ TestCase::TestResult ControlFlowGraphTest::run(std::ostream& _stream, std::strin
 
 	std::ostringstream output;
 
-	std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, *m_dialect, *object->code);
+	std::unique_ptr<GasMeter> gasMeter;
+	if (m_splitLargeSwitches)
+	{
+		auto const* evmDialect = dynamic_cast<EVMDialect const*>(m_dialect);
+		soltestAssert(evmDialect, "Splitting large switches requires an EVM dialect.");
+		// Runtime code with the default number of runs of the optimizer.
+		gasMeter = std::make_unique<GasMeter>(*evmDialect, false, 200);
+	}
+	std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, *m_dialect, *object->code, gasMeter.get());
 
 	output << "digraph CFG {\nnodesep=0.7;\nnode[shape=box];\n\n";
 	ControlFlowGraphPrinter printer{output};
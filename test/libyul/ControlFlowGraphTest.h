@@ -38,6 +38,8 @@ public:
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 private:
 	Dialect const* m_dialect = nullptr;
+	/// Whether to pass a gas meter to the builder, which allows it to split large switches.
+	bool m_splitLargeSwitches = false;
 };
 }
 }
@@ -28,6 +28,8 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/view/reverse.hpp>
@@ -225,14 +227,27 @@ TestCase::TestResult StackLayoutGeneratorTest::run(std::ostream& _stream, std::s
 	std::ostringstream output;
 
 	std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, *m_dialect, *object->code);
-	StackLayout stackLayout = StackLayoutGenerator::run(*cfg);
+	auto const printLayout = [&](std::ostream& _output, StackLayout const& _stackLayout) {
+		_output << "digraph CFG {\nnodesep=0.7;\nnode[shape=box];\n\n";
+		StackLayoutPrinter printer{_output, _stackLayout};
+		printer(*cfg->entry);
+		for (auto function: cfg->functions)
+			printer(cfg->functionInfo.at(function));
+		_output << "}\n";
+	};
+	printLayout(output, StackLayoutGenerator::run(*cfg));
 
-	output << "digraph CFG {\nnodesep=0.7;\nnode[shape=box];\n\n";
-	StackLayoutPrinter printer{output, stackLayout};
-	printer(*cfg->entry);
-	for (auto function: cfg->functions)
-		printer(cfg->functionInfo.at(function));
-	output << "}\n";
+	// Generating the layouts of the entry points concurrently must not change the result.
+	ThreadPool threadPool(3);
+	std::ostringstream concurrentOutput;
+	printLayout(concurrentOutput, StackLayoutGenerator::run(*cfg, &threadPool));
+	if (concurrentOutput.str() != output.str())
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) <<
+			_linePrefix << "Stack layout generated on multiple threads differs:" << std::endl;
+		printPrefixed(_stream, concurrentOutput.str(), _linePrefix + "  ");
+		return TestResult::Failure;
+	}
 
 	m_obtainedResult = output.str();
 
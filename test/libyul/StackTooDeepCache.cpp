@@ -0,0 +1,136 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sharing the stack too deep analysis between the stack compressor
+ * and the stack limit evader.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StackLimitEvader.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const source = R"({
+	{
+		mstore(0x40, memoryguard(128))
+		sstore(0, f(0))
+		sstore(1, g(1, 2))
+	}
+	function f(a1) -> v
+	{
+		let a2 := calldataload(mul(2, 4))
+		let a3 := calldataload(mul(3, 4))
+		let a4 := calldataload(mul(4, 4))
+		let a5 := calldataload(mul(5, 4))
+		let a6 := calldataload(mul(6, 4))
+		let a7 := calldataload(mul(7, 4))
+		let a8 := calldataload(mul(8, 4))
+		let a9 := calldataload(mul(9, 4))
+		let a10 := calldataload(mul(10, 4))
+		let a11 := calldataload(mul(11, 4))
+		let a12 := calldataload(mul(12, 4))
+		let a13 := calldataload(mul(13, 4))
+		let a14 := calldataload(mul(14, 4))
+		let a15 := calldataload(mul(15, 4))
+		let a16 := calldataload(mul(16, 4))
+		let a17 := calldataload(mul(17, 4))
+		sstore(mul(17, 4), a17)
+		sstore(mul(16, 4), a16)
+		sstore(mul(15, 4), a15)
+		sstore(mul(14, 4), a14)
+		sstore(mul(13, 4), a13)
+		sstore(mul(12, 4), a12)
+		sstore(mul(11, 4), a11)
+		sstore(mul(10, 4), a10)
+		sstore(mul(9, 4), a9)
+		sstore(mul(8, 4), a8)
+		sstore(mul(7, 4), a7)
+		sstore(mul(6, 4), a6)
+		sstore(mul(5, 4), a5)
+		sstore(mul(4, 4), a4)
+		sstore(mul(3, 4), a3)
+		sstore(mul(2, 4), a2)
+		sstore(mul(1, 4), a1)
+		v := a1
+	}
+	function g(x, y) -> z
+	{
+		z := add(x, y)
+	}
+})";
+
+/// Runs the stack compressor followed by the stack limit evader on @a _source, like the optimiser
+/// suite does, and @returns the resulting code.
+std::string compressAndEvade(std::string const& _source, StackLayoutGenerator::StackTooDeepCache* _cache)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	ErrorList errors;
+	std::shared_ptr<Object> object = parse(_source, dialect, errors).first;
+	BOOST_REQUIRE(object && errors.empty());
+
+	std::set<YulString> reservedIdentifiers;
+	NameDispenser dispenser{dialect, *object->code, reservedIdentifiers};
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200};
+	StackCompressor::run(dialect, *object, true, 16, _cache);
+	size_t const analysedAfterCompression = _cache ? _cache->size() : 0;
+	StackLimitEvader::run(context, *object, _cache);
+	if (_cache && dialect.evmVersion().canOverchargeGasForCall())
+	{
+		// The main block and the functions f and g were analysed by the stack compressor, which
+		// only modifies f, so the stack limit evader adds at most an entry for f.
+		BOOST_CHECK_EQUAL(analysedAfterCompression, 3);
+		BOOST_CHECK_LE(_cache->size(), analysedAfterCompression + 1);
+	}
+	return AsmPrinter{dialect, std::nullopt, DebugInfoSelection::None()}(*object->code);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(StackTooDeepCache)
+
+BOOST_AUTO_TEST_CASE(shared_between_compressor_and_evader)
+{
+	StackLayoutGenerator::StackTooDeepCache cache;
+	std::string const cached = compressAndEvade(source, &cache);
+	std::string const uncached = compressAndEvade(source, nullptr);
+	BOOST_CHECK_EQUAL(cached, uncached);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
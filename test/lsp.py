@@ -10,6 +10,8 @@ import os
 import re
 import subprocess
 import sys
+import tempfile
+import time
 import traceback
 from collections import namedtuple
 from copy import deepcopy
@@ -1610,6 +1612,92 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 0)
         # The warning went away because the compiler aborts further processing after the error.
 
+    def test_files_on_disk_changed_within_timestamp_granularity(self, solc: JsonRpcProcess) -> None:
+        """
+        Files that are not open in the editor are read from disk again when they changed,
+        even if the change kept their size and happened within the granularity of the
+        file system's timestamps.
+        """
+        valid = (
+            "// SPDX-License-Identifier: UNLICENSED\n"
+            "pragma solidity >=0.0;\n"
+            "contract C { function f() public pure returns (uint) { return 1; } }\n"
+        )
+        invalid = valid.replace("uint", "bool")
+        other = (
+            "// SPDX-License-Identifier: UNLICENSED\n"
+            "pragma solidity >=0.0;\n"
+            "contract D {}\n"
+        )
+
+        with tempfile.TemporaryDirectory(dir=self.project_root_dir) as project_dir:
+            SUBDIR = os.path.basename(project_dir)
+
+            def write_file(name: str, content: str) -> None:
+                # Truncate the modification time to seconds, so that rewriting the file within
+                # the same second keeps it, like on file systems with coarse timestamps.
+                path = f"{project_dir}/{name}.sol"
+                with open(path, mode="w", encoding="utf-8", newline='') as f:
+                    f.write(content)
+                now = int(time.time())
+                os.utime(path, (now, now))
+
+            def change_other_file(version: int) -> List[dict]:
+                solc.send_message(
+                    'textDocument/didChange',
+                    {
+                        'textDocument': {
+                            'uri': self.get_test_file_uri('D', SUBDIR),
+                            'version': version
+                        },
+                        'contentChanges': [{'text': other + "\n" * version}]
+                    }
+                )
+                return self.wait_for_diagnostics(solc)
+
+            write_file('C', valid)
+            write_file('D', other)
+            self.setup_lsp(
+                solc,
+                file_load_strategy=FileLoadStrategy.ProjectDirectory,
+                project_root_subdir=SUBDIR
+            )
+            published_diagnostics = self.wait_for_diagnostics(solc)
+            self.expect_equal(len(published_diagnostics), 2, "Diagnostic reports for 2 files")
+            self.expect_equal(published_diagnostics[0]['uri'], self.get_test_file_uri('C', SUBDIR))
+            self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics")
+
+            solc.send_message(
+                'textDocument/didOpen',
+                {
+                    'textDocument': {
+                        'uri': self.get_test_file_uri('D', SUBDIR),
+                        'languageId': 'Solidity',
+                        'version': 1,
+                        'text': other
+                    }
+                }
+            )
+            self.wait_for_diagnostics(solc)
+
+            # Same size and likely the same modification time, but a type error.
+            write_file('C', invalid)
+            published_diagnostics = change_other_file(2)
+            self.expect_equal(len(published_diagnostics), 2, "Diagnostic reports for 2 files")
+            self.expect_equal(published_diagnostics[0]['uri'], self.get_test_file_uri('C', SUBDIR))
+            self.expect_equal(len(published_diagnostics[0]['diagnostics']), 1, "type error in changed file")
+
+            # And back again.
+            write_file('C', valid)
+            published_diagnostics = change_other_file(3)
+            self.expect_equal(published_diagnostics[0]['uri'], self.get_test_file_uri('C', SUBDIR))
+            self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics after revert")
+
+            # Without changes on disk, the diagnostics stay the same.
+            published_diagnostics = change_other_file(4)
+            self.expect_equal(published_diagnostics[0]['uri'], self.get_test_file_uri('C', SUBDIR))
+            self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics without changes")
+
     def test_textDocument_didOpen_with_relative_import_without_project_url(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc, expose_project_root=False)
         TEST_NAME = 'didOpen_with_import'
@@ -1721,6 +1809,156 @@ class SolidityLSPTestSuite: # {{{
         self.expect_diagnostic(diagnostics[0], code=6321, marker=markers["@unusedReturnVariable"])
         self.expect_diagnostic(diagnostics[1], code=2072, marker=markers["@unusedContractVariable"])
 
+    def test_textDocument_hover_during_analysis(self, solc: JsonRpcProcess) -> None:
+        """
+        Requests that arrive while an edit is still being analyzed in the background are
+        answered from the previous analysis, while the diagnostics of the new one are
+        published concurrently.
+        """
+        self.setup_lsp(solc)
+        TEST_NAME = 'publish_diagnostics_1'
+        HOVER_COUNT = 20
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, "goto")
+        markers = self.get_test_tags(TEST_NAME, "goto")
+
+        solc.send_message(
+            'textDocument/didChange',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri(TEST_NAME, "goto")
+                },
+                'contentChanges': [
+                    {
+                        'range': extendEnd(markers["@unusedVariable"]),
+                        'text': ""
+                    }
+                ]
+            }
+        )
+        # The edit does not move the hovered line, so both analyses give the same answer.
+        for _ in range(HOVER_COUNT):
+            solc.send_message(
+                'textDocument/hover',
+                {
+                    'textDocument': {
+                        'uri': self.get_test_file_uri(TEST_NAME, "goto")
+                    },
+                    'position': markers["@unusedContractVariable"]["start"]
+                }
+            )
+
+        # Hover responses and diagnostics may arrive interleaved.
+        hover_responses = []
+        reports = []
+        report_count = None
+        while len(hover_responses) < HOVER_COUNT or report_count is None or len(reports) < report_count:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' not in message:
+                hover_responses.append(message)
+            elif message['method'] == '$/logTrace':
+                report_count = message['params']['openFileCount']
+            else:
+                reports.append(self.require_params_for_method('textDocument/publishDiagnostics', message))
+
+        for response in hover_responses:
+            self.expect_true('error' not in response, "hover answered")
+            self.expect_true('MyContract' in response['result']['contents']['value'], "hover shows the contract type")
+
+        self.expect_equal(len(reports), 1)
+        self.expect_equal(reports[0]['uri'], self.get_test_file_uri(TEST_NAME, "goto"), "Correct file URI")
+        diagnostics = reports[0]['diagnostics']
+        self.expect_equal(len(diagnostics), 2)
+        self.expect_diagnostic(diagnostics[0], code=6321, marker=markers["@unusedReturnVariable"])
+        self.expect_diagnostic(diagnostics[1], code=2072, marker=markers["@unusedContractVariable"])
+
+    def test_textDocument_semanticTokens_full_delta_and_range(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        SUB_DIR = 'semanticTokens'
+        TEST_NAME = 'enums'
+        TEXT_DOCUMENT = {'uri': self.get_test_file_uri(TEST_NAME, SUB_DIR)}
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, SUB_DIR)
+
+        tokens = [
+            1, 0, 24, 8, 0,
+            2, 5, 7, 2, 0,
+            1, 4, 5, 3, 0,
+            1, 4, 6, 3, 0,
+            1, 4, 5, 3, 0,
+            3, 5, 5, 2, 0,
+            1, 4, 3, 3, 0,
+            1, 4, 5, 3, 0,
+            1, 4, 4, 3, 0,
+            3, 9, 12, 5, 0,
+            0, 29, 5, 2, 0,
+            0, 6, 6, 19, 0,
+            2, 4, 6, 2, 0,
+            0, 9, 5, 2, 0,
+            0, 6, 3, 3, 0
+        ]
+        response = solc.call_method('textDocument/semanticTokens/full', {'textDocument': TEXT_DOCUMENT})
+        self.expect_equal(response['result'], {'resultId': '1', 'data': tokens}, part=ExpectationFailed.Part.Methods)
+
+        # Nothing changed yet.
+        response = solc.call_method(
+            'textDocument/semanticTokens/full/delta',
+            {'textDocument': TEXT_DOCUMENT, 'previousResultId': '1'}
+        )
+        self.expect_equal(response['result'], {'resultId': '2', 'edits': []}, part=ExpectationFailed.Part.Methods)
+
+        # Renaming `Rainy` to `Stormy` only changes the length of its token.
+        solc.send_message(
+            'textDocument/didChange',
+            {
+                'textDocument': TEXT_DOCUMENT,
+                'contentChanges': [
+                    {
+                        'range': {'start': {'line': 6, 'character': 4}, 'end': {'line': 6, 'character': 9}},
+                        'text': "Stormy"
+                    }
+                ]
+            }
+        )
+        self.wait_for_diagnostics(solc)
+        response = solc.call_method(
+            'textDocument/semanticTokens/full/delta',
+            {'textDocument': TEXT_DOCUMENT, 'previousResultId': '2'}
+        )
+        self.expect_equal(
+            response['result'],
+            {'resultId': '3', 'edits': [{'start': 22, 'deleteCount': 1, 'data': [6]}]},
+            part=ExpectationFailed.Part.Methods
+        )
+
+        # An outdated result ID gets all tokens.
+        tokens[22] = 6
+        response = solc.call_method(
+            'textDocument/semanticTokens/full/delta',
+            {'textDocument': TEXT_DOCUMENT, 'previousResultId': '1'}
+        )
+        self.expect_equal(response['result'], {'resultId': '4', 'data': tokens}, part=ExpectationFailed.Part.Methods)
+
+        # The tokens of `enum Color`, encoded relative to the start of the document.
+        response = solc.call_method(
+            'textDocument/semanticTokens/range',
+            {
+                'textDocument': TEXT_DOCUMENT,
+                'range': {'start': {'line': 9, 'character': 0}, 'end': {'line': 13, 'character': 0}}
+            }
+        )
+        self.expect_equal(
+            response['result'],
+            {
+                'data': [
+                    9, 5, 5, 2, 0,
+                    1, 4, 3, 3, 0,
+                    1, 4, 5, 3, 0,
+                    1, 4, 4, 3, 0
+                ]
+            },
+            part=ExpectationFailed.Part.Methods
+        )
+
     def test_textDocument_didChange_delete_line_and_close(self, solc: JsonRpcProcess) -> None:
         # Reuse this test to prepare and ensure it is as expected
         self.test_textDocument_didOpen_with_relative_import(solc)
@@ -105,8 +105,11 @@ void FuzzerUtil::testCompiler(
 	{
 		forceSMT(_input);
 		compiler.setModelCheckerSettings({
+			/*batchTargets=*/false,
 			/*bmcLoopIterations*/1,
+			/*cacheDirectory=*/std::nullopt,
 			frontend::ModelCheckerContracts::Default(),
+			/*crossCheckSolvers=*/true,
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
@@ -115,8 +118,10 @@ void FuzzerUtil::testCompiler(
 			/*showProvedSafe=*/false,
 			/*showUnproved=*/false,
 			/*showUnsupported=*/false,
+			/*smtlib2Solver=*/std::nullopt,
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
+			/*threads=*/1,
 			/*timeout=*/1
 		});
 	}